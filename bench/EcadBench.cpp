@@ -0,0 +1,399 @@
+#include "SyntheticDesign.hpp"
+#include "solver/thermal/utils/EPrismThermalNetworkBuilder.h"
+#include "solver/thermal/network/ThermalNetworkSolver.h"
+#include "solver/thermal/EThermalNetworkSolver.h"
+#include "model/thermal/io/EPrismThermalModelIO.h"
+#include "model/thermal/io/EGridThermalModelIO.h"
+#include "model/geometry/ELayerCutModel.h"
+#include "extension/gds/EGdsFileIO.h"
+#include "generic/tools/FileSystem.hpp"
+#include "basic/ECadVersion.h"
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <map>
+
+using namespace ecad;
+
+namespace {
+
+struct BenchSettings
+{
+    size_t repeat = 3;
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    EFloat meshMaxLen = 1000;//um
+    size_t meshIteration = 10000;
+    size_t gridSize = 128;
+    EFloat transientDuration = 1;//s
+    std::string workDir;
+    std::string output;
+    bench::SyntheticDesignSettings design;
+};
+
+struct StageResult
+{
+    std::string name;
+    std::vector<double> seconds;
+    std::map<std::string, double> metrics;//from the last run
+};
+
+class Bench
+{
+public:
+    explicit Bench(const BenchSettings & settings) : m_settings(settings) {}
+
+    template <typename Func>
+    void Time(const std::string & name, Func && func)
+    {
+        auto iter = std::find_if(m_results.begin(), m_results.end(), [&name](const auto & r) { return r.name == name; });
+        if (iter == m_results.end()) iter = m_results.insert(iter, StageResult{name, {}, {}});
+        auto & result = *iter;
+        auto start = std::chrono::steady_clock::now();
+        func(result.metrics);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        result.seconds.emplace_back(elapsed.count());
+        std::cout << std::left << std::setw(16) << name << std::fixed << std::setprecision(4) << elapsed.count() << "s" << std::endl;
+    }
+
+    bool Run(size_t index);
+    bool WriteJson(const std::string & filename) const;
+
+private:
+    const BenchSettings & m_settings;
+    std::vector<StageResult> m_results;
+};
+
+bool Bench::Run(size_t index)
+{
+    auto & eDataMgr = EDataMgr::Instance();
+    const auto & s = m_settings;
+    const auto threads = s.threads;
+    bool ok = true;
+
+    auto gdsFile = s.workDir + ECAD_SEPS + "bench.gds";
+    auto gdsMap = s.workDir + ECAD_SEPS + "bench.elm";
+    if (0 == index) bench::WriteSyntheticGds(gdsFile, gdsMap, s.design);
+
+    Time("import", [&](auto & metrics) {
+        auto database = eDataMgr.CreateDatabaseFromGds("bench_gds", gdsFile, gdsMap);
+        ok = ok && database;
+        metrics["boundaries"] = s.design.gdsBoundaries;
+        metrics["bytes"] = std::filesystem::file_size(gdsFile);
+    });
+    eDataMgr.RemoveDatabase("bench_gds");
+    if (not ok) return false;
+
+    Time("gds_read", [&](auto & metrics) {
+        auto start = std::chrono::steady_clock::now();
+        ext::gds::EGdsDB db;
+        ext::gds::EGdsReader reader(db);
+        ok = reader(gdsFile);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        metrics["objects"] = db.Cells().empty() ? 0 : db.Cells().front().objects.size();
+        metrics["mb_per_s"] = std::filesystem::file_size(gdsFile) / 1048576.0 / elapsed.count();
+    });
+    if (not ok) return false;
+
+    auto ctmPower = s.workDir + ECAD_SEPS + "bench_power.ctm";
+    auto ctmDensity = s.workDir + ECAD_SEPS + "bench_density.ctm";
+    if (0 == index) bench::WriteSyntheticCTM(ctmPower, ctmDensity, s.design);
+
+    Time("ctm_read", [&](auto & metrics) {
+        using namespace model::io::detail;
+        auto start = std::chrono::steady_clock::now();
+        model::EGridData powers(s.design.ctmSize, s.design.ctmSize);
+        std::vector<SPtr<model::EGridData> > density;
+        for (size_t i = 0; i < s.design.ctmLayers; ++i)
+            density.push_back(std::make_shared<model::EGridData>(s.design.ctmSize, s.design.ctmSize));
+        ok = ParseCTMv1PowerFile(ctmPower, powers) && ParseCTMv1DensityFile(ctmDensity, powers.Size(), density);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        auto bytes = std::filesystem::file_size(ctmPower) + std::filesystem::file_size(ctmDensity);
+        metrics["tiles"] = powers.Size();
+        metrics["mb_per_s"] = bytes / 1048576.0 / elapsed.count();
+    });
+    if (not ok) return false;
+
+    Ptr<ILayoutView> layout{nullptr};
+    Time("generate", [&](auto & metrics) {
+        layout = bench::CreateSyntheticLayout("bench", s.design, threads);
+        if (layout) metrics["primitives"] = layout->GetPrimitiveCollection()->Size();
+    });
+    if (nullptr == layout) return false;
+
+    Time("polygon_merge", [&](auto & metrics) {
+        ELayoutPolygonMergeSettings mergeSettings(threads, {});
+        ok = layout->MergeLayerPolygons(mergeSettings);
+        metrics["primitives"] = layout->GetPrimitiveCollection()->Size();
+    });
+
+    EPrismThermalModelExtractionSettings prismSettings(s.workDir, threads, {});
+    prismSettings.meshSettings.iteration = s.meshIteration;
+    prismSettings.meshSettings.minAlpha = 20;
+    prismSettings.meshSettings.minLen = 1e-2;
+    prismSettings.meshSettings.maxLen = s.meshMaxLen;
+    prismSettings.layerCutSettings.dumpSketchImg = false;
+    prismSettings.botUniformBC.type = EThermalBoundaryConditionType::HTC;
+    prismSettings.botUniformBC.value = 2750;
+
+    Time("layer_cut", [&](auto & metrics) {
+        auto lcModel = dynamic_cast<CPtr<model::ELayerCutModel>>(layout->ExtractLayerCutModel(prismSettings.layerCutSettings));
+        ok = ok && lcModel;
+        if (lcModel) metrics["layers"] = lcModel->TotalLayers();
+    });
+
+    //the layer cut model is cached by the layout, so this stage only times meshing and prism model building
+    CPtr<model::EPrismThermalModel> prismModel{nullptr};
+    Time("mesh", [&](auto & metrics) {
+        prismModel = dynamic_cast<CPtr<model::EPrismThermalModel>>(layout->ExtractThermalModel(prismSettings));
+        if (nullptr == prismModel) return;
+        metrics["prisms"] = prismModel->TotalPrismElements();
+        metrics["lines"] = prismModel->TotalLineElements();
+    });
+    if (not ok || nullptr == prismModel) return false;
+
+    //global to local prism index, binary search over the layer offsets against the former linear scan,
+    //the gap grows with the layer count, run with --layers 25 or more for 50+ model layers
+    Time("local_index", [&](auto & metrics) {
+        const size_t prisms = prismModel->TotalPrismElements();
+        const size_t layers = prismModel->TotalLayers();
+        if (0 == prisms) return;
+        std::vector<size_t> offsets;
+        for (size_t i = 0; i < layers; ++i)
+            offsets.emplace_back(prismModel->GlobalIndex(i, 0));
+        offsets.emplace_back(prisms);
+        auto linearScan = [&](size_t index) {
+            size_t lyr = 0;
+            while (not (offsets[lyr] <= index && index < offsets[lyr + 1])) lyr++;
+            return std::make_pair(lyr, index - offsets[lyr]);
+        };
+
+        //strided access so neighbouring calls hit different layers like the neighbor lookups of the builders
+        const size_t calls = std::max<size_t>(prisms, 1 << 22);
+        auto timeCalls = [&](auto && localIndex) {
+            size_t checksum{0};
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0, index = 0; i < calls; ++i, index = (index + 7919) % prisms) {
+                auto [lyr, ele] = localIndex(index);
+                checksum += lyr + ele;
+            }
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            return std::make_pair(elapsed.count() / calls, checksum);
+        };
+        auto [linearNs, linearSum] = timeCalls(linearScan);
+        auto [binaryNs, binarySum] = timeCalls([&](size_t index) { return prismModel->PrismLocalIndex(index); });
+        ok = ok && linearSum == binarySum;
+        metrics["layers"] = layers;
+        metrics["linear_ns"] = linearNs;
+        metrics["binary_ns"] = binaryNs;
+        metrics["speedup"] = linearNs / binaryNs;
+    });
+    if (not ok) return false;
+
+    Time("grid_model", [&](auto & metrics) {
+        EGridThermalModelExtractionSettings gridSettings(s.workDir, threads, {});
+        gridSettings.metalFractionMappingSettings.grid = {s.gridSize, s.gridSize};
+        gridSettings.metalFractionMappingSettings.mergeGeomBeforeMapping = false;
+        gridSettings.botUniformBC = prismSettings.botUniformBC;
+        auto gridModel = dynamic_cast<CPtr<model::EGridThermalModel>>(layout->ExtractThermalModel(gridSettings));
+        ok = ok && gridModel;
+        if (gridModel) metrics["grids"] = gridModel->TotalGrids();
+    });
+
+    using Scalar = solver::EThermalNetworkStaticSolver::Scalar;
+    const auto envT = ETemperature::Celsius2Kelvins(25);
+    UPtr<thermal::model::ThermalNetwork<Scalar> > network;
+    Time("network_build", [&](auto & metrics) {
+        solver::EPrismThermalNetworkBuilder<Scalar> builder(*prismModel);
+        std::vector<Scalar> iniT(prismModel->TotalElements(), envT);
+        network = builder.Build(iniT, threads);
+        ok = ok && network;
+        if (nullptr == network) return;
+        metrics["nodes"] = network->Size();
+        metrics["edges"] = network->TotalEdges();
+    });
+    if (not ok) return false;
+
+    //same network and tolerance, only the preconditioner of the conjugate gradient differs
+    auto iterativeSolve = [&](EThermalNetworkStaticSolverType type, auto & metrics) {
+        std::vector<Scalar> results;
+        thermal::solver::ThermalNetworkStaticSolveSession<Scalar> session(static_cast<int>(type));
+        ok = ok && session.Solve(*network, envT, results);
+        if (results.empty()) return;
+        metrics["iterations"] = session.Iterations();
+        metrics["error"] = session.Error();
+        metrics["maxT"] = ETemperature::Kelvins2Celsius(*std::max_element(results.begin(), results.end()));
+    };
+    Time("cg_diagonal", [&](auto & metrics) { iterativeSolve(EThermalNetworkStaticSolverType::ConjugateGradient, metrics); });
+    Time("cg_amg", [&](auto & metrics) { iterativeSolve(EThermalNetworkStaticSolverType::ConjugateGradientAMG, metrics); });
+    network.reset();
+
+    std::vector<Scalar> temperatures;
+    Time("static_solve", [&](auto & metrics) {
+        solver::EThermalNetworkStaticSolver staticSolver;
+        staticSolver.settings.threads = threads;
+        staticSolver.settings.iteration = 1;
+        ok = ok && staticSolver.Solve<solver::EPrismThermalNetworkBuilder<Scalar>>(*prismModel, temperatures);
+        if (temperatures.empty()) return;
+        metrics["maxT"] = ETemperature::Kelvins2Celsius(*std::max_element(temperatures.begin(), temperatures.end()));
+    });
+
+    Time("transient_solve", [&](auto & metrics) {
+        EThermalTransientExcitation excitation = [](EFloat t, size_t) -> EFloat { return std::fmod(t, 0.02) < 0.01 ? 1 : 0; };
+        solver::EPrismThermalNetworkTransientSolver transientSolver(*prismModel, excitation);
+        transientSolver.settings.threads = threads;
+        prismModel->SearchElementIndices(bench::SyntheticDieMonitors(s.design), transientSolver.settings.probs);
+        transientSolver.settings.dumpResults = false;
+        transientSolver.settings.temperatureDepend = false;
+        transientSolver.settings.integrator = EThermalTransientIntegrator::BackwardEuler;
+        transientSolver.settings.duration = s.transientDuration;
+        transientSolver.settings.step = s.transientDuration / 100;
+        transientSolver.settings.samplingWindow = s.transientDuration;
+        transientSolver.settings.minSamplingInterval = s.transientDuration / 100;
+        transientSolver.settings.absoluteError = 1e-5;
+        transientSolver.settings.relativeError = 1e-5;
+        auto [minT, maxT] = transientSolver.Solve();
+        ok = ok && isValid(maxT);
+        metrics["maxT"] = maxT;
+        ECAD_UNUSED(minT)
+    });
+
+    Time("export", [&](auto & metrics) {
+        auto vtuFile = s.workDir + ECAD_SEPS + "bench.vtu";
+        ok = ok && model::io::GenerateVTUFile<Scalar>(vtuFile, *prismModel, &temperatures);
+        if (std::filesystem::exists(vtuFile)) metrics["bytes"] = std::filesystem::file_size(vtuFile);
+    });
+
+    eDataMgr.RemoveDatabase("bench");
+    return ok;
+}
+
+bool Bench::WriteJson(const std::string & filename) const
+{
+    std::ofstream out(filename);
+    if (not out.is_open()) return false;
+
+    const auto & s = m_settings;
+#ifdef NDEBUG
+    const char * buildType = "Release";
+#else
+    const char * buildType = "Debug";
+#endif//NDEBUG
+    out << std::setprecision(9);
+    out << "{" << ECAD_EOL;
+    out << "  \"version\": \"" << toString(CURRENT_VERSION) << "\"," << ECAD_EOL;
+    out << "  \"compiler\": \"" << __VERSION__ << "\"," << ECAD_EOL;
+    out << "  \"build_type\": \"" << buildType << "\"," << ECAD_EOL;
+    out << "  \"settings\": {" << ECAD_EOL;
+    out << "    \"repeat\": " << s.repeat << ", \"threads\": " << s.threads << ", \"seed\": " << s.design.seed << "," << ECAD_EOL;
+    out << "    \"dies\": " << s.design.dies << ", \"traces\": " << s.design.traces << ", \"layers\": " << s.design.layers << ", \"gds_boundaries\": " << s.design.gdsBoundaries << ", \"ctm_size\": " << s.design.ctmSize << "," << ECAD_EOL;
+    out << "    \"mesh_max_len\": " << s.meshMaxLen << ", \"mesh_iteration\": " << s.meshIteration << ", \"grid_size\": " << s.gridSize << ", \"transient_duration\": " << s.transientDuration << ECAD_EOL;
+    out << "  }," << ECAD_EOL;
+    out << "  \"stages\": [" << ECAD_EOL;
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        const auto & r = m_results.at(i);
+        auto sorted = r.seconds;
+        std::sort(sorted.begin(), sorted.end());
+        out << "    {\"name\": \"" << r.name << "\", \"unit\": \"s\", \"min\": " << sorted.front()
+            << ", \"median\": " << sorted.at(sorted.size() / 2) << ", \"max\": " << sorted.back() << ", \"runs\": [";
+        for (size_t j = 0; j < r.seconds.size(); ++j)
+            out << (j ? ", " : "") << r.seconds.at(j);
+        out << "], \"metrics\": {";
+        size_t j = 0;
+        for (const auto & [key, value] : r.metrics)
+            out << (j++ ? ", " : "") << "\"" << key << "\": " << value;
+        out << "}}" << (i + 1 < m_results.size() ? "," : "") << ECAD_EOL;
+    }
+    out << "  ]" << ECAD_EOL;
+    out << "}" << ECAD_EOL;
+    return out.good();
+}
+
+void PrintUsage()
+{
+    std::cout << "usage: ecad_bench [options]" << std::endl
+              << "  --dies N           dies per board side (default 4)" << std::endl
+              << "  --traces N         traces per die site and layer (default 16)" << std::endl
+              << "  --layers N         conducting layers (default 2)" << std::endl
+              << "  --gds-boundaries N boundaries in the synthetic gds (default 200000)" << std::endl
+              << "  --ctm-size N       tiles per side of the synthetic ctm maps (default 2000)" << std::endl
+              << "  --mesh-max-len L   prism mesh max edge length in um (default 1000)" << std::endl
+              << "  --grid-size N      grid thermal model resolution (default 128)" << std::endl
+              << "  --duration T       transient duration in s (default 1)" << std::endl
+              << "  --seed S           random seed (default 20240101)" << std::endl
+              << "  --threads N        worker threads (default hardware concurrency)" << std::endl
+              << "  --repeat N         pipeline repetitions (default 3)" << std::endl
+              << "  --work-dir DIR     scratch directory (default ./ecad_bench)" << std::endl
+              << "  --output FILE      json results (default <work-dir>/bench.json)" << std::endl;
+}
+
+bool ParseArgs(int argc, char * argv[], BenchSettings & s)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if ("-h" == arg || "--help" == arg) return false;
+        if (i + 1 == argc) {
+            std::cerr << "missing value of " << arg << std::endl;
+            return false;
+        }
+        std::string value(argv[++i]);
+        if ("--dies" == arg) s.design.dies = std::stoul(value);
+        else if ("--traces" == arg) s.design.traces = std::stoul(value);
+        else if ("--layers" == arg) s.design.layers = std::max<size_t>(1, std::stoul(value));
+        else if ("--gds-boundaries" == arg) s.design.gdsBoundaries = std::stoul(value);
+        else if ("--ctm-size" == arg) s.design.ctmSize = std::max<size_t>(1, std::stoul(value));
+        else if ("--mesh-max-len" == arg) s.meshMaxLen = std::stod(value);
+        else if ("--grid-size" == arg) s.gridSize = std::stoul(value);
+        else if ("--duration" == arg) s.transientDuration = std::stod(value);
+        else if ("--seed" == arg) s.design.seed = std::stoul(value);
+        else if ("--threads" == arg) s.threads = std::max<size_t>(1, std::stoul(value));
+        else if ("--repeat" == arg) s.repeat = std::max<size_t>(1, std::stoul(value));
+        else if ("--work-dir" == arg) s.workDir = value;
+        else if ("--output" == arg) s.output = value;
+        else {
+            std::cerr << "unknown option " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    BenchSettings settings;
+    if (not ParseArgs(argc, argv, settings)) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+    if (settings.workDir.empty()) settings.workDir = generic::fs::CurrentPath().string() + ECAD_SEPS + "ecad_bench";
+    if (settings.output.empty()) settings.output = settings.workDir + ECAD_SEPS + "bench.json";
+    if (not generic::fs::CreateDir(settings.workDir)) {
+        std::cerr << "fail to create " << settings.workDir << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto & eDataMgr = EDataMgr::Instance();
+    eDataMgr.Init(ELogLevel::Info, settings.workDir);
+    eDataMgr.SetThreads(settings.threads);
+
+    Bench bench(settings);
+    for (size_t i = 0; i < settings.repeat; ++i) {
+        std::cout << "run " << i + 1 << "/" << settings.repeat << std::endl;
+        if (not bench.Run(i)) {
+            std::cerr << "benchmark pipeline failed, see " << settings.workDir << ECAD_SEPS << "ecad.log" << std::endl;
+            eDataMgr.ShutDown(false);
+            return EXIT_FAILURE;
+        }
+    }
+    if (not bench.WriteJson(settings.output)) {
+        std::cerr << "fail to write " << settings.output << std::endl;
+        eDataMgr.ShutDown(false);
+        return EXIT_FAILURE;
+    }
+    std::cout << "results: " << settings.output << std::endl;
+    eDataMgr.ShutDown(false);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+#include "solver/thermal/network/utils/ThermalNetworkSnapshot.h"
+#include "solver/thermal/network/ThermalNetworkSolver.h"
+#include <iostream>
+#include <iomanip>
+#include <charconv>
+#include <chrono>
+
+using namespace thermal;
+using generic::ckt::DenseVector;
+
+namespace {
+
+struct ReplaySettings
+{
+    int solverType = -1;//-1: solver type recorded in the snapshot
+    size_t repeat = 3;
+    std::string snapshot;
+    std::string output;
+};
+
+template <typename Func>
+double Time(const std::string & name, Func && func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::left << std::setw(16) << name << std::fixed << std::setprecision(4) << elapsed.count() << "s" << std::endl;
+    return elapsed.count();
+}
+
+///@brief replays G x = B rhs exactly as ThermalNetworkStaticSolveSession::Solve did when the snapshot was dumped
+template <typename Scalar>
+bool Replay(const ReplaySettings & s)
+{
+    utils::ThermalNetworkSnapshot<Scalar> snapshot;
+    bool ok = true;
+    Time("load", [&] { ok = utils::ThermalNetworkSnapshotIO::Read(s.snapshot, snapshot); });
+    if (not ok) {
+        std::cerr << "fail to read " << s.snapshot << std::endl;
+        return false;
+    }
+    const int solverType = s.solverType < 0 ? snapshot.solverType : s.solverType;
+    std::cout << "nodes: " << snapshot.G.rows() << ", nnz(G): " << snapshot.G.nonZeros() << ", sources: " << snapshot.rhs.size()
+              << ", scalar: " << sizeof(Scalar) << " bytes, solver type: " << solverType
+              << ", initial guess: " << (snapshot.x0.size() ? "recorded" : "zero") << std::endl;
+
+    DenseVector<Scalar> b = snapshot.B * snapshot.rhs;
+    //the session warm starts from result when its size matches, as the original solve did from the recorded guess
+    std::vector<Scalar> result, x0(snapshot.x0.data(), snapshot.x0.data() + snapshot.x0.size());
+    for (size_t i = 0; i < s.repeat; ++i) {
+        //a fresh session per run so the symbolic analysis is timed as well
+        solver::ThermalNetworkStaticSolveSession<Scalar> session(solverType);
+        Time("prepare", [&] { session.Prepare(snapshot.G); });
+        result = x0;
+        Time("solve", [&] { session.Solve(b, result); });
+        if (solverType >= 10)
+            std::cout << "iterations: " << session.Iterations() << ", estimated error: " << session.Error() << std::endl;
+    }
+
+    Eigen::Map<const DenseVector<Scalar>> x(result.data(), result.size());
+    const auto bNorm = b.norm();
+    const auto residual = (snapshot.G * x - b).norm() / (bNorm > 0 ? bNorm : Scalar{1});
+    std::cout << std::scientific << "relative residual: " << residual << std::fixed << std::endl;
+    if (not result.empty()) {
+        auto [minT, maxT] = std::minmax_element(result.begin(), result.end());
+        std::cout << "temperature: [" << *minT << ", " << *maxT << "]" << std::endl;
+    }
+    if (not s.output.empty() && not utils::ThermalNetworkSnapshotIO::WriteMatrixMarket(s.output, DenseVector<Scalar>(x))) {
+        std::cerr << "fail to write " << s.output << std::endl;
+        return false;
+    }
+    return true;
+}
+
+///@brief the whole string as a number of type T, false if it is not a number or out of range
+template <typename T>
+bool ParseNumber(const std::string & value, T & number)
+{
+    const char * end = value.data() + value.size();
+    auto [ptr, ec] = std::from_chars(value.data(), end, number);
+    return std::errc() == ec && end == ptr;
+}
+
+void PrintUsage()
+{
+    std::cout << "usage: ecad_solve_replay [options] snapshot.bin" << std::endl
+              << "  --solver N   static solver type, 0: lu, 1: cholesky, 2: llt, 3: ldlt, 10: cg, 11: amg-cg" << std::endl
+              << "               (default the one recorded in the snapshot)" << std::endl
+              << "  --repeat N   prepare and solve repetitions (default 3)" << std::endl
+              << "  --output F   write the solution in matrix market format" << std::endl;
+}
+
+bool ParseArgs(int argc, char * argv[], ReplaySettings & s)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if ("-h" == arg || "--help" == arg) return false;
+        if (0 != arg.rfind("--", 0)) {
+            s.snapshot = arg;
+            continue;
+        }
+        if (i + 1 == argc) {
+            std::cerr << "missing value of " << arg << std::endl;
+            return false;
+        }
+        std::string value(argv[++i]);
+        bool valid = true;
+        if ("--solver" == arg) valid = ParseNumber(value, s.solverType) && s.solverType >= 0;
+        else if ("--repeat" == arg) valid = ParseNumber(value, s.repeat) && s.repeat > 0;
+        else if ("--output" == arg) s.output = value;
+        else {
+            std::cerr << "unknown option " << arg << std::endl;
+            return false;
+        }
+        if (not valid) {
+            std::cerr << "invalid value " << value << " of " << arg << std::endl;
+            return false;
+        }
+    }
+    return not s.snapshot.empty();
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    ReplaySettings settings;
+    if (not ParseArgs(argc, argv, settings)) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+    bool ok = false;
+    switch (utils::ThermalNetworkSnapshotIO::ScalarSize(settings.snapshot)) {
+        case sizeof(float) : ok = Replay<float>(settings); break;
+        case sizeof(double) : ok = Replay<double>(settings); break;
+        default : std::cerr << settings.snapshot << " is not a thermal network snapshot" << std::endl; break;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,202 @@
+#pragma once
+#include "extension/gds/EGdsRecords.h"
+#include "model/thermal/io/EChipThermalModelIO.h"
+#include "EDataMgr.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <cmath>
+namespace ecad::bench {
+
+///@brief size of the procedurally generated designs, identical parameters and seed give identical designs
+struct SyntheticDesignSettings
+{
+    size_t dies = 4;//dies per side
+    size_t traces = 16;//traces per die site and conducting layer
+    size_t layers = 2;//conducting layers, separated by dielectric layers
+    size_t gdsBoundaries = 200000;
+    size_t ctmSize = 2000;//tiles per side of the ctm power and density maps
+    size_t ctmLayers = 6;//ctm density layers
+    uint32_t seed = 20240101;
+    EFloat pitch = 10000;//um, die site size
+};
+
+///@brief mt19937 output is fully specified by the standard, unlike the std distributions, so designs match across toolchains
+class SyntheticRandom
+{
+public:
+    explicit SyntheticRandom(uint32_t seed) : m_engine(seed) {}
+    ///@brief uniform in [0, 1)
+    EFloat Unit() { return m_engine() / 4294967296.0; }
+    EFloat Real(EFloat lo, EFloat hi) { return lo + (hi - lo) * Unit(); }
+    int Int(int lo, int hi) { return lo + static_cast<int>(m_engine() % uint32_t(hi - lo + 1)); }
+private:
+    std::mt19937 m_engine;
+};
+
+///@brief writes a flat GDSII library with one cell of random rectangles spread over all conducting layers, returns the file size
+inline size_t WriteSyntheticGds(const std::string & filename, const std::string & layerMap, const SyntheticDesignSettings & settings)
+{
+    using namespace ext::gds;
+    auto record = [](std::string & out, uint8_t type, uint8_t dataType, const std::string & payload = {}) {
+        auto size = 4 + payload.size();
+        out.push_back(char(size >> 8)); out.push_back(char(size & 0xff));
+        out.push_back(char(type)); out.push_back(char(dataType));
+        out.append(payload);
+    };
+    auto int2 = [](int v) { return std::string{char((v >> 8) & 0xff), char(v & 0xff)}; };
+    auto int4 = [](int v) { return std::string{char((v >> 24) & 0xff), char((v >> 16) & 0xff), char((v >> 8) & 0xff), char(v & 0xff)}; };
+    auto real8 = [](double v) {//excess-64 base-16
+        int e = 64;
+        while (v >= 1) { v /= 16; ++e; }
+        while (v < 1.0 / 16) { v *= 16; --e; }
+        auto m = static_cast<uint64_t>(std::ldexp(v, 56));
+        std::string s(1, char(e));
+        for (int i = 6; i >= 0; --i) s.push_back(char((m >> (8 * i)) & 0xff));
+        return s;
+    };
+
+    SyntheticRandom rng(settings.seed);
+    const int extent = static_cast<int>(settings.dies * settings.pitch * 1000);//nm
+    const int layers = static_cast<int>(settings.layers);
+
+    std::string gds;
+    gds.reserve(settings.gdsBoundaries * 64 + 1024);
+    std::string date; for (int i = 0; i < 12; ++i) date += int2(i < 6 ? 1 : 0);
+    record(gds, EGdsRecords::HEADER, 0x02, int2(600));
+    record(gds, EGdsRecords::BGNLIB, 0x02, date);
+    record(gds, EGdsRecords::LIBNAME, 0x06, "BENCH\0");
+    record(gds, EGdsRecords::UNITS, 0x05, real8(1e-3) + real8(1e-9));
+    record(gds, EGdsRecords::BGNSTR, 0x02, date);
+    record(gds, EGdsRecords::STRNAME, 0x06, "TOP\0");
+    for (size_t i = 0; i < settings.gdsBoundaries; ++i) {
+        int x = rng.Int(0, extent - 1), y = rng.Int(0, extent - 1), w = rng.Int(100, 20000), h = rng.Int(100, 20000);
+        record(gds, EGdsRecords::BOUNDARY, 0x00);
+        record(gds, EGdsRecords::LAYER, 0x02, int2(rng.Int(1, layers)));
+        record(gds, EGdsRecords::DATATYPE, 0x02, int2(0));
+        record(gds, EGdsRecords::XY, 0x03, int4(x) + int4(y) + int4(x + w) + int4(y) + int4(x + w) + int4(y + h) + int4(x) + int4(y + h) + int4(x) + int4(y));
+        record(gds, EGdsRecords::ENDEL, 0x00);
+    }
+    record(gds, EGdsRecords::ENDSTR, 0x00);
+    record(gds, EGdsRecords::ENDLIB, 0x00);
+    gds.append(2048 - gds.size() % 2048, '\0');
+
+    std::ofstream out(filename, std::ios::binary);
+    out.write(gds.data(), gds.size());
+
+    std::ofstream map(layerMap);
+    for (size_t i = settings.layers; i > 0; --i)
+        map << "M" << i << " m " << i << " 0 100" << ECAD_EOL;
+    return gds.size();
+}
+
+///@brief writes the binary CTMv1 power and metal density files of a ctmSize x ctmSize tile map, returns the total file size
+inline size_t WriteSyntheticCTM(const std::string & powerFile, const std::string & densityFile, const SyntheticDesignSettings & settings)
+{
+    using namespace model::io::detail;
+    const size_t nx = settings.ctmSize, ny = settings.ctmSize;
+    model::EGridData powers(nx, ny);
+    std::vector<SPtr<model::EGridData> > density;
+    for (size_t i = 0; i < settings.ctmLayers; ++i)
+        density.push_back(std::make_shared<model::EGridData>(nx, ny));
+
+    SyntheticRandom rng(settings.seed);
+    for (size_t i = 0; i < powers.Size(); ++i) {
+        powers[i] = rng.Real(0, 1e-3);
+        for (auto & layer : density) (*layer)[i] = rng.Unit();
+    }
+    if (not WriteCTMv1PowerFile(powerFile, powers) ||
+        not WriteCTMv1DensityFile(densityFile, powers.Size(), 1, FPoint2D(0, 0), density)) return 0;
+    return std::filesystem::file_size(powerFile) + std::filesystem::file_size(densityFile);
+}
+
+///@brief builds a board of dies x dies powered components on a copper/dielectric stackup with random traces, returns the flattened layout
+inline Ptr<ILayoutView> CreateSyntheticLayout(const std::string & name, const SyntheticDesignSettings & settings, size_t threads)
+{
+    auto & eDataMgr = EDataMgr::Instance();
+    auto database = eDataMgr.CreateDatabase(name);
+    if (nullptr == database) return nullptr;
+
+    auto matCu = database->CreateMaterialDef("Cu");
+    matCu->SetProperty(EMaterialPropId::ThermalConductivity, eDataMgr.CreatePolynomialMaterialProp({{437.6, -0.165, 1.825e-4, -1.427e-7, 3.979e-11}}));
+    matCu->SetProperty(EMaterialPropId::SpecificHeat, eDataMgr.CreatePolynomialMaterialProp({{342.8, 0.134, 5.535e-5, -1.971e-7, 1.141e-10}}));
+    matCu->SetProperty(EMaterialPropId::MassDensity, eDataMgr.CreateSimpleMaterialProp(8850));
+    matCu->SetProperty(EMaterialPropId::Resistivity, eDataMgr.CreateSimpleMaterialProp(1.68e-8));
+
+    auto matSiC = database->CreateMaterialDef("SiC");
+    matSiC->SetProperty(EMaterialPropId::ThermalConductivity, eDataMgr.CreatePolynomialMaterialProp({{1860, -11.7, 0.03442, -4.869e-5, 2.675e-8}}));
+    matSiC->SetProperty(EMaterialPropId::SpecificHeat, eDataMgr.CreatePolynomialMaterialProp({{-3338, 33.12, -0.1037, 0.0001522, -8.553e-8}}));
+    matSiC->SetProperty(EMaterialPropId::MassDensity, eDataMgr.CreateSimpleMaterialProp(3210));
+
+    auto matSi3N4 = database->CreateMaterialDef("Si3N4");
+    matSi3N4->SetProperty(EMaterialPropId::ThermalConductivity, eDataMgr.CreateSimpleMaterialProp(70));
+    matSi3N4->SetProperty(EMaterialPropId::SpecificHeat, eDataMgr.CreateSimpleMaterialProp(691));
+    matSi3N4->SetProperty(EMaterialPropId::MassDensity, eDataMgr.CreateSimpleMaterialProp(2400));
+
+    ECoordUnits coordUnits(ECoordUnits::Unit::Micrometer);
+    database->SetCoordUnits(coordUnits);
+
+    auto topCell = eDataMgr.CreateCircuitCell(database, "TopCell");
+    auto topLayout = topCell->GetLayoutView();
+    const EFloat width = settings.dies * settings.pitch;
+    topLayout->SetBoundary(std::make_unique<EPolygon>(eDataMgr.CreatePolygon(coordUnits, {{0, 0}, {width, 0}, {width, width}, {0, width}})));
+
+    EFloat elevation = 0, cuThickness = 300, dielThickness = 635;
+    std::vector<ELayerId> conductingLayers;
+    for (size_t i = 0; i < settings.layers; ++i) {
+        auto cu = "Cu" + std::to_string(i + 1);
+        conductingLayers.emplace_back(topLayout->AppendLayer(eDataMgr.CreateStackupLayer(cu, ELayerType::ConductingLayer, elevation, cuThickness, matCu->GetName(), matSi3N4->GetName())));
+        elevation -= cuThickness;
+        if (i + 1 == settings.layers) break;
+        auto diel = "Diel" + std::to_string(i + 1);
+        topLayout->AppendLayer(eDataMgr.CreateStackupLayer(diel, ELayerType::DielectricLayer, elevation, dielThickness, matSi3N4->GetName(), matSi3N4->GetName()));
+        elevation -= dielThickness;
+    }
+
+    const EFloat dieHeight = 365;
+    auto compDef = eDataMgr.CreateComponentDef(database, "Die");
+    compDef->SetBoundary(eDataMgr.CreateShapeRectangle(coordUnits, FPoint2D(-0.2 * settings.pitch, -0.2 * settings.pitch), FPoint2D(0.2 * settings.pitch, 0.2 * settings.pitch)));
+    compDef->SetMaterial(matSiC->GetName());
+    compDef->SetSolderFillingMaterial(matCu->GetName());
+    compDef->SetHeight(dieHeight);
+
+    SyntheticRandom rng(settings.seed);
+    auto net = eDataMgr.CreateNet(topLayout, "Power");
+    for (size_t i = 0; i < settings.dies; ++i) {
+        for (size_t j = 0; j < settings.dies; ++j) {
+            FPoint2D ll(i * settings.pitch, j * settings.pitch);
+            FVector2D center(ll[0] + 0.5 * settings.pitch, ll[1] + 0.5 * settings.pitch);
+            auto name = "D" + std::to_string(i) + "_" + std::to_string(j);
+            auto comp = eDataMgr.CreateComponent(topLayout, name, compDef, conductingLayers.front(), eDataMgr.CreateTransform2D(coordUnits, 1, 0, center), false);
+            comp->SetLossPower(ETemperature::Celsius2Kelvins(25), rng.Real(5, 20));
+
+            for (auto layer : conductingLayers) {
+                for (size_t t = 0; t < settings.traces; ++t) {
+                    //horizontal or vertical trace inside the die site
+                    auto l = rng.Real(0.2, 0.8) * settings.pitch, w = rng.Real(0.02, 0.1) * settings.pitch;
+                    auto x = ll[0] + rng.Unit() * (settings.pitch - l), y = ll[1] + rng.Unit() * (settings.pitch - w);
+                    auto shape = t % 2 ? eDataMgr.CreateShapeRectangle(coordUnits, FPoint2D(x, y), FPoint2D(x + l, y + w)) :
+                                         eDataMgr.CreateShapeRectangle(coordUnits, FPoint2D(ll[0] + y - ll[1], ll[1] + x - ll[0]), FPoint2D(ll[0] + y - ll[1] + w, ll[1] + x - ll[0] + l));
+                    eDataMgr.CreateGeometry2D(topLayout, layer, net->GetNetId(), std::move(shape));
+                }
+            }
+        }
+    }
+    //bottom plate
+    eDataMgr.CreateGeometry2D(topLayout, conductingLayers.back(), ENetId::noNet, eDataMgr.CreateShapeRectangle(coordUnits, FPoint2D(0, 0), FPoint2D(width, width)));
+
+    database->Flatten(topCell, threads);
+    return topCell->GetFlattenedLayoutView();
+}
+
+///@brief die center points of the synthetic layout, unit: um
+inline std::vector<FPoint3D> SyntheticDieMonitors(const SyntheticDesignSettings & settings)
+{
+    std::vector<FPoint3D> monitors;
+    for (size_t i = 0; i < settings.dies; ++i)
+        for (size_t j = 0; j < settings.dies; ++j)
+            monitors.emplace_back((i + 0.5) * settings.pitch, (j + 0.5) * settings.pitch, 0.5 * 365);
+    return monitors;
+}
+
+} // namespace ecad::bench
@@ -0,0 +1,69 @@
+import os
+import sys
+import time
+import threading
+import numpy
+import SetupDesign
+import StaticThermal
+from SetupDesign import ecad
+
+mgr = ecad.DataMgr
+
+# each design owns its database and work dir, heavy calls release the gil so the designs run in parallel
+# returns the time spent in run_thermal_simulation alone
+def run_design(index, results) :
+    work_dir = os.path.dirname(__file__) + f'/data/simulation/concurrent/design{index}'
+    layout = SetupDesign.setup_design(f'Tiny{index}', SetupDesign.chip_locations, work_dir, False)
+    assert(layout)
+    StaticThermal.setup_power(layout, True)
+    setup = StaticThermal.get_simulation_setup(layout, work_dir, ["BotBridge1"], ["Die1"], True)
+    start = time.time()
+    results[index] = layout.run_thermal_simulation(setup)
+    return time.time() - start
+
+def concurrent_static_thermal_flow(designs) :
+
+    # reference, one design at a time
+    start = time.time()
+    reference = [None]
+    simulation = run_design(0, reference)
+    serial = time.time() - start
+
+    # a ticker that only advances while no call holds the gil
+    ticks = []
+    done = threading.Event()
+    def ticker() :
+        while not done.is_set() :
+            ticks.append(time.time())
+            time.sleep(0.001)
+
+    results = [None] * designs
+    threads = [threading.Thread(target = run_design, args = (i, results)) for i in range(designs)]
+    tick_thread = threading.Thread(target = ticker)
+    start = time.time()
+    tick_thread.start()
+    for thread in threads : thread.start()
+    for thread in threads : thread.join()
+    concurrent = time.time() - start
+    done.set()
+    tick_thread.join()
+
+    max_gap = max(b - a for a, b in zip(ticks, ticks[1:])) if len(ticks) > 1 else concurrent
+    print(f'serial: {serial:.3f}s per design, simulation: {simulation:.3f}s, concurrent: {concurrent:.3f}s for {designs} designs, max gil gap: {max_gap:.3f}s')
+
+    ref_min, ref_max, ref_temperatures = reference[0]
+    for t_min, t_max, temperatures in results :
+        assert(t_min == ref_min and t_max == ref_max)
+        assert(numpy.array_equal(temperatures, ref_temperatures))
+    # the simulation releases the gil, so the ticker only stalls for the short python side calls, the gap depends on the
+    # machine load and is reported rather than checked
+
+def main() :
+
+    mgr.init(ecad.LogLevel.INFO)
+    mgr.set_threads(2)
+    concurrent_static_thermal_flow(4)
+    mgr.shut_down()
+
+if __name__ == '__main__' :
+    main()
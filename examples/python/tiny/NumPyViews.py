@@ -0,0 +1,51 @@
+import os
+import gc
+import numpy
+import SetupDesign
+import StaticThermal
+from SetupDesign import ecad
+
+mgr = ecad.DataMgr
+
+# grid data is shared as (width, height) with the height index contiguous, element (x, y) matches the c++ grid
+def check_grid_data(ctm_file) :
+    model = ecad.load_ctm_v1(ctm_file)
+    assert(model)
+    width, height = model.tiles
+    grid = model.get_power(model.temperatures[0])
+    assert(grid and grid.width() == width and grid.height() == height)
+    data = numpy.asarray(grid)
+    assert(data.shape == (width, height))
+    assert(data.strides == (data.itemsize * height, data.itemsize))
+    for x, y in [(0, 0), (width - 1, 0), (0, height - 1), (width - 1, height - 1), (width // 2, height // 3)] :
+        assert(data[x, y] == grid[x, y])
+
+# mesh views are read-only, one row per point or prism, and keep the model and its layout alive
+def check_prism_model(work_dir) :
+    layout = SetupDesign.setup_design('TinyViews', SetupDesign.chip_locations, work_dir, False)
+    assert(layout)
+    model = layout.extract_thermal_model(StaticThermal.get_extraction_setting(work_dir, True))
+    assert(model)
+    del layout
+    gc.collect()
+
+    points = model.points
+    assert(points.ndim == 2 and points.shape[1] == 3 and len(points) > 0)
+    assert(points.strides == (3 * points.itemsize, points.itemsize))
+    assert(not points.flags.writeable)
+
+    vertices = model.prism_vertices
+    assert(vertices.shape == (model.total_prism_elements(), 6))
+    assert(vertices.strides[1] == vertices.itemsize and vertices.strides[0] >= 6 * vertices.itemsize)
+    assert(not vertices.flags.writeable)
+    assert(vertices.size == 0 or vertices.max() < len(points))
+
+def main() :
+
+    mgr.init(ecad.LogLevel.INFO)
+    check_grid_data(os.path.dirname(__file__) + '/../../../test/data/ctm/test.tar.gz')
+    check_prism_model(os.path.dirname(__file__) + '/data/simulation/views')
+    mgr.shut_down()
+
+if __name__ == '__main__' :
+    main()
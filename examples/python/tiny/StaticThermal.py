@@ -84,7 +84,7 @@ def static_thermal_flow(chip_locations, include_joule_heat = True, show_heat_map
     if show_heat_map :
         try :
             import vtk
-            hotmap_vtk = work_dir + '/hotmap.vtk'
+            hotmap_vtk = work_dir + '/hotmap.vtu'
             if 'vtk' in sys.modules and os.path.exists(hotmap_vtk) :
                 sys.path.append(os.path.dirname(__file__) + '/../tools')
                 import HotmapViewer
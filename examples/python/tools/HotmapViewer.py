@@ -10,7 +10,10 @@ def view_hotmap(filename):
 
     # Create the reader for the data.
     print('Loading ', filename)
-    reader = vtk.vtkUnstructuredGridReader()
+    if filename.endswith('.vtu') :
+        reader = vtk.vtkXMLUnstructuredGridReader()
+    else :
+        reader = vtk.vtkUnstructuredGridReader()
     reader.SetFileName(filename)
     reader.Update()
 
@@ -20,9 +23,7 @@ def view_hotmap(filename):
     geometry_shrink.SetShrinkFactor(1.0)
 
     scalar = reader.GetOutput().GetCellData().GetScalars()
-    scalar_lut = scalar.GetLookupTable()
     scalar_bar = vtk.vtkScalarBarActor()
-    scalar_bar.SetLookupTable(scalar_lut)  # Link to the mapper's LUT
     scalar_bar.SetTitle("Temperature")
     scalar_bar.SetHeight(0.5)  # Adjust height as needed (0-1)
     scalar_bar.SetWidth(0.05)  # Adjust width as needed (0-1)
@@ -41,6 +42,12 @@ def view_hotmap(filename):
     geometry_mapper.SetScalarModeToUseCellData()
     geometry_mapper.SetScalarRange(scalar_range[0], scalar_range[1])
 
+    # legacy files carry their own lookup table, xml files use the mapper's one
+    scalar_lut = scalar.GetLookupTable()
+    if scalar_lut is None :
+        scalar_lut = geometry_mapper.GetLookupTable()
+    scalar_bar.SetLookupTable(scalar_lut)  # Link to the mapper's LUT
+
     geometry_actor = vtk.vtkActor()
     geometry_actor.SetMapper(geometry_mapper)
     geometry_actor.GetProperty().SetLineWidth(0.01)
@@ -2,6 +2,7 @@
 #include "PyEcadDesign.hpp"
 #include "PyEcadUtility.hpp"
 #include "PyEcadGeometry.hpp"
+#include "PyEcadModel.hpp"
 void ecad_init_datamgr(py::module_ & m)
 {
     //DataMgr
@@ -19,19 +20,27 @@ void ecad_init_datamgr(py::module_ & m)
             { return EDataMgr::Instance().OpenDatabase(name); }, py::return_value_policy::reference)
         .def("remove_database", [](const std::string & name)
             { return EDataMgr::Instance().RemoveDatabase(name); })
+        .def("create_database_from_gds", [](const std::string & name, const std::string & gds, const std::string & lyrMap)
+            { return EDataMgr::Instance().CreateDatabaseFromGds(name, gds, lyrMap); }, py::return_value_policy::reference, py::call_guard<py::gil_scoped_release>())
+        .def("create_database_from_gds", [](const std::string & name, const std::string & gds)
+            { return EDataMgr::Instance().CreateDatabaseFromGds(name, gds); }, py::return_value_policy::reference, py::call_guard<py::gil_scoped_release>())
+        .def("create_database_from_kicad", [](const std::string & name, const std::string & kicad)
+            { return EDataMgr::Instance().CreateDatabaseFromKiCad(name, kicad); }, py::return_value_policy::reference, py::call_guard<py::gil_scoped_release>())
+        .def("create_database_from_xfl", [](const std::string & name, const std::string & xfl)
+            { return EDataMgr::Instance().CreateDatabaseFromXfl(name, xfl); }, py::return_value_policy::reference, py::call_guard<py::gil_scoped_release>())
         .def("shut_down", [](bool autoSave)
             { EDataMgr::Instance().ShutDown(autoSave); })
         .def("shut_down", []
             { EDataMgr::Instance().ShutDown(); })
 #ifdef ECAD_BOOST_SERIALIZATION_SUPPORT
         .def("save_database", [](CPtr<IDatabase> database, const std::string & archive, EArchiveFormat fmt)
-            { EDataMgr::Instance().SaveDatabase(database, archive, fmt); })
+            { EDataMgr::Instance().SaveDatabase(database, archive, fmt); }, py::call_guard<py::gil_scoped_release>())
         .def("save_database", [](CPtr<IDatabase> database, const std::string & archive)
-            { EDataMgr::Instance().SaveDatabase(database, archive); })
+            { EDataMgr::Instance().SaveDatabase(database, archive); }, py::call_guard<py::gil_scoped_release>())
         .def("load_database", [](const std::string & archive, EArchiveFormat fmt)
-            { return EDataMgr::Instance().LoadDatabase(archive, fmt); }, py::return_value_policy::reference)
+            { return EDataMgr::Instance().LoadDatabase(archive, fmt); }, py::return_value_policy::reference, py::call_guard<py::gil_scoped_release>())
         .def("load_database", [](const std::string & archive)
-            { return EDataMgr::Instance().LoadDatabase(archive); }, py::return_value_policy::reference)
+            { return EDataMgr::Instance().LoadDatabase(archive); }, py::return_value_policy::reference, py::call_guard<py::gil_scoped_release>())
 #endif//ECAD_BOOST_SERIALIZATION_SUPPORT
 
         // cell
@@ -122,9 +131,14 @@ void ecad_init_datamgr(py::module_ & m)
 
 PYBIND11_MODULE(PyEcad, ecad)
 {
+    ecad.doc() = R"(Thread safety: imports, database save/load, flattening, thermal model extraction and
+thermal simulations release the GIL, so different designs can be processed from several python threads.
+The database registry of DataMgr is thread-safe. A database, its cells and layouts must only be used by one
+thread at a time, and concurrent simulations must not share a work directory.)";
     ecad_init_basic(ecad);
     ecad_init_design(ecad);
     ecad_init_utility(ecad);
+    ecad_init_model(ecad);
     ecad_init_datamgr(ecad);
 
     //sub modules
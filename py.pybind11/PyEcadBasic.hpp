@@ -178,6 +178,14 @@ void ecad_init_basic(py::module_ & m)
         .value("LLT", EThermalNetworkStaticSolverType::LLT)
         .value("LDLT", EThermalNetworkStaticSolverType::LDLT)
         .value("CONJUGATE_GRADIENT", EThermalNetworkStaticSolverType::ConjugateGradient)
+        .value("CONJUGATE_GRADIENT_AMG", EThermalNetworkStaticSolverType::ConjugateGradientAMG)
+    ;
+
+    py::enum_<EThermalTransientIntegrator>(m, "ThermalTransientIntegrator")
+        .value("EXPLICIT", EThermalTransientIntegrator::Explicit)
+        .value("BACKWARD_EULER", EThermalTransientIntegrator::BackwardEuler)
+        .value("TRAPEZOIDAL", EThermalTransientIntegrator::Trapezoidal)
+        .value("BDF2", EThermalTransientIntegrator::BDF2)
     ;
 
     py::class_<EPoint2D>(m, "Point2D")
@@ -317,6 +325,7 @@ void ecad_init_basic(py::module_ & m)
         .def_readwrite("layer_transition_ratio", &ELayerCutModelExtractionSettings::layerTransitionRatio)
         .def_readwrite("add_circle_center_as_steiner_point", &ELayerCutModelExtractionSettings::addCircleCenterAsSteinerPoint)
         .def_readwrite("imprint_box", &ELayerCutModelExtractionSettings::imprintBox)
+        .def_readwrite("cache_dir", &ELayerCutModelExtractionSettings::cacheDir)
     ;
 
     py::class_<EPrismMeshSettings, EMeshSettings>(m, "PrismMeshSettings")
@@ -337,6 +346,7 @@ void ecad_init_basic(py::module_ & m)
         .def_readwrite("force_rebuild", &EThermalModelExtractionSettings::forceRebuild)
         .def_readwrite("threads", &EThermalModelExtractionSettings::threads)
         .def_readwrite("work_dir", &EThermalModelExtractionSettings::workDir)
+        .def_readwrite("cache_dir", &EThermalModelExtractionSettings::cacheDir)
         .def_readwrite("top_uniform_bc", &EThermalModelExtractionSettings::topUniformBC)
         .def_readwrite("bot_uniform_bc", &EThermalModelExtractionSettings::botUniformBC)
         .def_readwrite("top_block_bc", &EThermalModelExtractionSettings::topBlockBC)
@@ -370,6 +380,13 @@ void ecad_init_basic(py::module_ & m)
         .def_readwrite("solver_type", &EThermalStaticSettings::solverType)
     ;
 
+    py::class_<EThermalStaticSweepCase>(m, "ThermalStaticSweepCase")
+        .def(py::init<>())
+        .def_readwrite("htc_scale", &EThermalStaticSweepCase::htcScale)
+        .def_readwrite("env_temperature", &EThermalStaticSweepCase::envTemperature)
+        .def_readwrite("power_scales", &EThermalStaticSweepCase::powerScales)
+    ;
+
     py::class_<EThermalModelReductionSettings>(m, "ThermalModelReductionSettings")
         .def_readwrite("order", &EThermalModelReductionSettings::order)
         .def_readwrite("rom_load_file", &EThermalModelReductionSettings::romLoadFile)
@@ -387,6 +404,7 @@ void ecad_init_basic(py::module_ & m)
         .def_readwrite("relative_error", &EThermalTransientSettings::relativeError)
         .def_readwrite("min_sampling_interval", &EThermalTransientSettings::minSamplingInterval)
         .def_readwrite("sampling_window", &EThermalTransientSettings::samplingWindow)
+        .def_readwrite("integrator", &EThermalTransientSettings::integrator)
         .def_readwrite("mor", &EThermalTransientSettings::mor)
     ;
 
@@ -1,8 +1,27 @@
 #pragma once
 #include <pybind11/functional.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 #include "EDataMgr.h"
 
 using namespace ecad;
-namespace py = pybind11;
\ No newline at end of file
+namespace py = pybind11;
+
+///@brief moves the vector into a numpy array that owns it, no per element conversion
+template <typename T>
+inline py::array_t<T> toNumPy(std::vector<T> && data)
+{
+    auto owned = new std::vector<T>(std::move(data));
+    py::capsule base(owned, [](void * p) { delete reinterpret_cast<std::vector<T> *>(p); });
+    return py::array_t<T>(owned->size(), owned->data(), base);
+}
+
+///@brief read-only numpy array sharing memory with the c++ object behind base, base is kept alive by the array
+template <typename T>
+inline py::array_t<T> makeNumPyView(std::vector<py::ssize_t> shape, std::vector<py::ssize_t> strides, const T * data, py::handle base)
+{
+    py::array_t<T> view(std::move(shape), std::move(strides), data, base);
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+}
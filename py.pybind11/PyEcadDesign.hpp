@@ -6,7 +6,7 @@ void ecad_init_design(py::module_ & m)
     py::class_<ICell>(m, "Cell")
         .def("get_name", &ICell::GetName, py::return_value_policy::reference)
         .def("get_layout_view", &ICell::GetLayoutView, py::return_value_policy::reference)
-        .def("get_flattened_layout_view", &ICell::GetFlattenedLayoutView, py::return_value_policy::reference)
+        .def("get_flattened_layout_view", &ICell::GetFlattenedLayoutView, py::return_value_policy::reference, py::call_guard<py::gil_scoped_release>())
     ;
 
     py::class_<ICellInst>(m, "CellInst")
@@ -67,13 +67,31 @@ void ecad_init_design(py::module_ & m)
         })
         .def("get_layer_iter", &ILayoutView::GetLayerIter)
         .def("get_primitive_iter", &ILayoutView::GetPrimitiveIter)
-        .def("flatten", &ILayoutView::Flatten)
+        .def("flatten", &ILayoutView::Flatten, py::call_guard<py::gil_scoped_release>())
+        //the layout owns the model and stays alive as long as the model does
+        .def("extract_thermal_model", &ILayoutView::ExtractThermalModel, py::return_value_policy::reference_internal, py::call_guard<py::gil_scoped_release>(),
+             "the model and its array views are invalidated when the layout rebuilds it, i.e. extracting or simulating again with other settings")
         .def("run_thermal_simulation", [](ILayoutView & layout, const EThermalStaticSimulationSetup & simulationSetup){
             std::vector<EFloat> temperatures;
-            auto range = layout.RunThermalSimulation(simulationSetup, temperatures);
-            return std::make_tuple(range.first, range.second, temperatures);
+            EPair<EFloat, EFloat> range;
+            {
+                py::gil_scoped_release release;
+                range = layout.RunThermalSimulation(simulationSetup, temperatures);
+            }
+            return std::make_tuple(range.first, range.second, toNumPy(std::move(temperatures)));
+        })
+        .def("run_thermal_simulation", py::overload_cast<const EThermalTransientSimulationSetup &, const EThermalTransientExcitation &>(&ILayoutView::RunThermalSimulation), py::call_guard<py::gil_scoped_release>())
+        .def("run_thermal_sweep", [](ILayoutView & layout, const EThermalStaticSimulationSetup & simulationSetup, const std::vector<EThermalStaticSweepCase> & cases){
+            std::vector<std::vector<EFloat> > temperatures;
+            std::vector<EPair<EFloat, EFloat> > ranges;
+            {
+                py::gil_scoped_release release;
+                ranges = layout.RunThermalSweep(simulationSetup, cases, temperatures);
+            }
+            std::vector<py::array_t<EFloat> > results;
+            for (auto & t : temperatures) results.emplace_back(toNumPy(std::move(t)));
+            return std::make_tuple(ranges, results);
         })
-        .def("run_thermal_simulation", py::overload_cast<const EThermalTransientSimulationSetup &, const EThermalTransientExcitation &>(&ILayoutView::RunThermalSimulation))
     ;
 
     py::class_<IBondwire>(m, "Bondwire")
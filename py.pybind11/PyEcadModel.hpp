@@ -0,0 +1,62 @@
+#pragma once
+#include "PyEcadCommon.hpp"
+#include "model/thermal/EStackupPrismThermalModel.h"
+#include "model/thermal/io/EChipThermalModelIO.h"
+
+void ecad_init_model(py::module_ & m)
+{
+    using namespace model;
+    //grid data supports the buffer protocol, numpy.asarray(grid) shares its memory, shape is (width, height)
+    py::class_<EGridData, SPtr<EGridData> >(m, "GridData", py::buffer_protocol())
+        .def_buffer([](EGridData & data) {
+            return py::buffer_info(&data[0], sizeof(EFloat), py::format_descriptor<EFloat>::format(), 2,
+                                   {data.Width(), data.Height()}, {sizeof(EFloat) * data.Height(), sizeof(EFloat)});
+        })
+        .def("width", [](const EGridData & data){ return data.Width(); })
+        .def("height", [](const EGridData & data){ return data.Height(); })
+        .def("__getitem__", [](const EGridData & data, std::pair<size_t, size_t> xy){
+            if (xy.first >= data.Width() || xy.second >= data.Height()) throw py::index_error();
+            return data(xy.first, xy.second);
+        })
+    ;
+
+    py::class_<IModel>(m, "Model")
+    ;
+
+    py::class_<EChipThermalModelV1, IModel>(m, "ChipThermalModelV1")
+        .def_property_readonly("temperatures", [](const EChipThermalModelV1 & model){ return model.header.temperatures; })
+        .def_property_readonly("tiles", [](const EChipThermalModelV1 & model){ return std::make_tuple(model.header.tiles.x, model.header.tiles.y); })
+        .def_readonly("densities", &EChipThermalModelV1::densities)
+        .def("get_power", [](const EChipThermalModelV1 & model, EFloat temperature){
+            return model.powers ? model.powers->GetTable().GetTable(temperature) : nullptr;
+        }, py::return_value_policy::reference_internal)
+    ;
+
+    //mesh arrays are read-only views into the model, the model stays alive as long as any view does, until its layout rebuilds it
+    py::class_<EPrismThermalModel, IModel>(m, "PrismThermalModel")
+        .def("total_layers", &EPrismThermalModel::TotalLayers)
+        .def("total_elements", &EPrismThermalModel::TotalElements)
+        .def("total_prism_elements", &EPrismThermalModel::TotalPrismElements)
+        .def("total_line_elements", &EPrismThermalModel::TotalLineElements)
+        .def_property_readonly("points", [](py::object self){
+            static_assert(sizeof(FPoint3D) == 3 * sizeof(FCoord));
+            const auto & points = self.cast<const EPrismThermalModel &>().GetPoints();
+            auto data = reinterpret_cast<const FCoord *>(points.data());
+            return makeNumPyView<FCoord>({py::ssize_t(points.size()), 3}, {sizeof(FPoint3D), sizeof(FCoord)}, data, self);
+        })
+        .def_property_readonly("prism_vertices", [](py::object self){
+            //top then bot triangle of each prism, a strided view of PrismInstance::vertices
+            const auto & model = self.cast<const EPrismThermalModel &>();
+            auto size = model.TotalPrismElements();
+            auto data = 0 == size ? nullptr : model.GetPrism(0).vertices.data();
+            return makeNumPyView<size_t>({py::ssize_t(size), 6}, {sizeof(PrismInstance), sizeof(size_t)}, data, self);
+        })
+    ;
+
+    py::class_<EStackupPrismThermalModel, EPrismThermalModel>(m, "StackupPrismThermalModel")
+    ;
+
+    m.def("load_ctm_v1", [](const std::string & filename){
+        return io::makeChipThermalModelFromCTMv1File(filename);
+    }, py::call_guard<py::gil_scoped_release>());
+}
@@ -37,6 +37,7 @@ ECAD_INLINE EDataMgr::~EDataMgr()
 
 ECAD_INLINE Ptr<IDatabase> EDataMgr::CreateDatabase(const std::string & name)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (m_databases.count(name)) return nullptr;
 
     auto database = std::make_shared<EDatabase>(name);
@@ -45,6 +46,7 @@ ECAD_INLINE Ptr<IDatabase> EDataMgr::CreateDatabase(const std::string & name)
 
 ECAD_INLINE Ptr<IDatabase> EDataMgr::OpenDatabase(const std::string & name)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     auto iter = m_databases.find(name);
     if (iter == m_databases.cend()) return nullptr;
     return iter->second.get();
@@ -52,13 +54,17 @@ ECAD_INLINE Ptr<IDatabase> EDataMgr::OpenDatabase(const std::string & name)
 
 ECAD_INLINE bool EDataMgr::RemoveDatabase(const std::string & name)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     return m_databases.erase(std::string(name)) > 0;
 }
 
 ECAD_INLINE void EDataMgr::ShutDown(bool autoSave)
 {
     //todo
-    m_databases.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_databases.clear();
+    }
 
     log::ShutDown();
 }
@@ -89,6 +95,7 @@ ECAD_INLINE Ptr<IDatabase> EDataMgr::LoadDatabase(const std::string & archive, E
 {
     auto database = std::make_shared<EDatabase>("");
     if (not database->Load(archive, fmt)) return nullptr;
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (m_databases.count(database->GetName())) return nullptr;
     return m_databases.emplace(database->GetName(), database).first->second.get();
 }
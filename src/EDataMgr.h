@@ -17,7 +17,7 @@ public:
     EDataMgr & operator= (const EDataMgr &) = delete;
     void Init(ELogLevel level = ELogLevel::Info, const std::string & workDir = {});
 
-    ///Database
+    ///Database, the database registry may be used from several threads, each database is modified by one thread at a time
     Ptr<IDatabase> CreateDatabase(const std::string & name);
     Ptr<IDatabase> OpenDatabase(const std::string & name);
     bool RemoveDatabase(const std::string & name);
@@ -129,6 +129,7 @@ private:
     ~EDataMgr();
 
     EDataMgrSettings m_settings;
+    mutable std::mutex m_mutex;//guards m_databases
     std::unordered_map<std::string, SPtr<IDatabase> > m_databases;
 };
 
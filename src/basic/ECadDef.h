@@ -235,6 +235,7 @@ ECAD_ALWAYS_INLINE std::string toString(EModelType type)
     switch(type)
     {
         case EModelType::Invalid : return "Invalid";
+        case EModelType::LayerCut : return "LayerCut";
         case EModelType::ThermalCTMv1 : return "ThermalCTMv1";
         case EModelType::ThermalGrid : return "ThermalGrid";
         case EModelType::ThermalPrism : return "ThermalPrism";
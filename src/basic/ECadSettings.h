@@ -1,6 +1,7 @@
 #pragma once
 #include "ECadCommon.h"
 #include <unordered_set>
+#include <unordered_map>
 #include <functional>
 #include <array>
 #include <set>
@@ -210,6 +211,7 @@ struct ELayerCutModelExtractionSettings : public ECadSettings
     EFloat layerTransitionRatio = 2;
     bool addCircleCenterAsSteinerPoint{false};
     std::vector<FBox2D> imprintBox;
+    std::string cacheDir;//directory of the on-disk model cache, disabled if empty, not archived
 
     virtual bool operator== (const ECadSettings & settings) const override
     {
@@ -281,6 +283,7 @@ struct EThermalModelExtractionSettings : public ECadSettings, public Clonable<ET
     bool forceRebuild{false};
     size_t threads;
     std::string workDir;
+    std::string cacheDir;//directory of the on-disk model cache, disabled if empty, not archived
     EThermalBoundaryCondition topUniformBC;
     EThermalBoundaryCondition botUniformBC;
     std::vector<BlockBoundaryCondition> topBlockBC;
@@ -435,6 +438,7 @@ enum class EThermalNetworkStaticSolverType
     LLT = 2,
     LDLT = 3,
     ConjugateGradient = 10,
+    ConjugateGradientAMG = 11,//smoothed aggregation multigrid preconditioned
 };
 
 struct EThermalSettings
@@ -464,8 +468,24 @@ struct EThermalStaticSimulationSetup : public EThermalSimulationSetup
     EThermalStaticSettings settings;
 };
 
+///@brief one evaluation of a static sweep, the network is built once and a case only changes the boundary conductance and the right-hand side
+struct EThermalStaticSweepCase
+{
+    EFloat htcScale = 1;//scales all convective boundary conditions, uniform and block
+    ETemperature envTemperature{25, ETemperatureUnit::Celsius};
+    std::unordered_map<size_t, EFloat> powerScales;//[scenario, scale], scenarios not listed keep their power
+};
+
 using EThermalTransientExcitation = std::function<EFloat(EFloat, size_t)>;//ratio = f(t, scenario), range[0, 1]
 
+enum class EThermalTransientIntegrator
+{
+    Explicit = 0,//runge kutta
+    BackwardEuler = 1,
+    Trapezoidal = 2,
+    BDF2 = 3,
+};
+
 struct EThermalModelReductionSettings
 {
     size_t order = 0;
@@ -484,6 +504,7 @@ struct EThermalTransientSettings : public EThermalSettings
     EFloat relativeError{1e-6};
     EFloat minSamplingInterval{0};
     EFloat samplingWindow{0};
+    EThermalTransientIntegrator integrator{EThermalTransientIntegrator::Explicit};
     EThermalModelReductionSettings mor;
     explicit EThermalTransientSettings(size_t threads) : EThermalSettings(threads) {}
     virtual ~EThermalTransientSettings() = default;
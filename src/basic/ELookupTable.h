@@ -1,6 +1,12 @@
 #pragma once
 #include "ECadCommon.h"
 #include "Protocol.h"
+#ifdef ECAD_BOOST_SERIALIZATION_SUPPORT
+#include <boost/serialization/split_member.hpp>
+#endif//ECAD_BOOST_SERIALIZATION_SUPPORT
+#include <algorithm>
+#include <vector>
+#include <map>
 namespace ecad {
 
 //todo refactor
@@ -56,66 +62,127 @@ public:
     }
 };
 
-//todo refactor
+///@brief piecewise linear table on sorted contiguous samples, clamped to the end values outside the sampled range
 class ELookupTable1D : public Printable
 {
 #ifdef ECAD_BOOST_SERIALIZATION_SUPPORT
     friend class boost::serialization::access;
     
+    ///@note archived as a key-value map, same layout as the former map storage
     template <typename Archive>
-    void serialize(Archive & ar, const unsigned int version)
+    void save(Archive & ar, const unsigned int version) const
     {
         ECAD_UNUSED(version)
-        ar & boost::serialization::make_nvp("data", m_data);
+        std::map<EFloat, EFloat> data;
+        for (size_t i = 0; i < m_keys.size(); ++i)
+            data.emplace(m_keys[i], m_values[i]);
+        ar & boost::serialization::make_nvp("data", data);
     }
 
+    template <typename Archive>
+    void load(Archive & ar, const unsigned int version)
+    {
+        ECAD_UNUSED(version)
+        std::map<EFloat, EFloat> data;
+        ar & boost::serialization::make_nvp("data", data);
+        m_keys.clear(); m_values.clear(); m_slopes.clear();
+        for (const auto & [key, value] : data)
+            AddSample(key, value);
+    }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
 #endif//ECAD_BOOST_SERIALIZATION_SUPPORT
-    using DataType = std::map<EFloat, EFloat>;
 public:
     ELookupTable1D() = default;
     virtual ~ELookupTable1D() = default;
+    ///@brief keeps the first value if the key is already sampled
     void AddSample(EFloat key, EFloat value);
     EFloat Lookup(EFloat key) const;
+    ///@brief evaluates size keys in one pass over the contiguous samples
+    template <typename Key, typename Value>
+    void Lookup(const Key * keys, Value * values, size_t size) const;
     bool Empty() const;
+    size_t Size() const;
 
-    typename DataType::iterator begin() { return m_data.begin(); }
-    typename DataType::iterator end() { return m_data.end(); }
-    typename DataType::const_iterator cbegin() { return m_data.cbegin(); }
-    typename DataType::const_iterator cend() { return m_data.cend(); }
+    const std::vector<EFloat> & Keys() const { return m_keys; }
+    const std::vector<EFloat> & Values() const { return m_values; }
 
 protected:
     virtual void PrintImp(std::ostream & os) const override;
+    ///@brief index i of the segment [keys[i], keys[i + 1]] to interpolate in, the key is already clamped
+    size_t Segment(EFloat key) const;
 
 protected:
-    DataType m_data;
+    std::vector<EFloat> m_keys;//ascending
+    std::vector<EFloat> m_values;
+    std::vector<EFloat> m_slopes;//of segment i, size - 1 entries
 };
 
 ECAD_ALWAYS_INLINE void ELookupTable1D::AddSample(EFloat key, EFloat value)
 {
-    m_data.emplace(key, value);
+    auto iter = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+    if (iter != m_keys.end() && *iter == key) return;
+    auto i = static_cast<size_t>(std::distance(m_keys.begin(), iter));
+    m_values.insert(m_values.begin() + i, value);
+    m_keys.insert(iter, key);
+    if (m_keys.size() < 2) return;
+    //the new sample splits segment i - 1 or extends either end, only the slopes next to it change
+    m_slopes.insert(m_slopes.begin() + std::min(i, m_slopes.size()), EFloat(0));
+    auto slope = [this](size_t s) { return (m_values[s + 1] - m_values[s]) / (m_keys[s + 1] - m_keys[s]); };
+    if (i > 0) m_slopes[i - 1] = slope(i - 1);
+    if (i + 1 < m_keys.size()) m_slopes[i] = slope(i);
+}
+
+ECAD_ALWAYS_INLINE size_t ELookupTable1D::Segment(EFloat key) const
+{
+    //the last key is excluded so the segment index stays within [0, size - 2]
+    return std::distance(m_keys.begin(), std::upper_bound(m_keys.begin() + 1, m_keys.end() - 1, key)) - 1;
 }
 
 ECAD_ALWAYS_INLINE EFloat ELookupTable1D::Lookup(EFloat key) const
 {
-    if (m_data.empty()) return 0;
-    if (m_data.size() == 1) return m_data.begin()->second;
-    if (key < m_data.begin()->first) return m_data.begin()->second;
-    if (key > m_data.rbegin()->first) return m_data.rbegin()->second;
-    auto h = m_data.lower_bound(key); if (h == m_data.begin()) return h->second;
-    auto l = h; l--;
-    return l->second + (key - l->first) * (h->second - l->second) / (h->first - l->first);
+    if (m_keys.size() < 2) return m_keys.empty() ? 0 : m_values.front();
+    key = std::clamp(key, m_keys.front(), m_keys.back());
+    auto i = Segment(key);
+    return m_values[i] + (key - m_keys[i]) * m_slopes[i];
+}
+
+template <typename Key, typename Value>
+ECAD_ALWAYS_INLINE void ELookupTable1D::Lookup(const Key * keys, Value * values, size_t size) const
+{
+    if (m_keys.size() < 2) {
+        std::fill(values, values + size, m_keys.empty() ? Value(0) : Value(m_values.front()));
+        return;
+    }
+    const EFloat lo = m_keys.front(), hi = m_keys.back();
+    if (2 == m_keys.size()) {
+        //single segment, no search, the loop vectorizes
+        const EFloat v0 = m_values.front(), slope = m_slopes.front();
+        for (size_t k = 0; k < size; ++k)
+            values[k] = static_cast<Value>(v0 + (std::clamp<EFloat>(keys[k], lo, hi) - lo) * slope);
+        return;
+    }
+    for (size_t k = 0; k < size; ++k) {
+        auto key = std::clamp<EFloat>(keys[k], lo, hi);
+        auto i = Segment(key);
+        values[k] = static_cast<Value>(m_values[i] + (key - m_keys[i]) * m_slopes[i]);
+    }
 }
 
 ECAD_ALWAYS_INLINE bool ELookupTable1D::Empty() const
 {
-    return m_data.empty();
+    return m_keys.empty();
+}
+
+ECAD_ALWAYS_INLINE size_t ELookupTable1D::Size() const
+{
+    return m_keys.size();
 }
 
 ECAD_ALWAYS_INLINE void ELookupTable1D::PrintImp(std::ostream & os) const
 {
     os << '{';
-    for (auto [key, value] : m_data)
-        os << '{' << key << ',' << value << "},";
+    for (size_t i = 0; i < m_keys.size(); ++i)
+        os << '{' << m_keys[i] << ',' << m_values[i] << "},";
     os << '}' << ECAD_EOL;
 }
 
@@ -0,0 +1,76 @@
+#include "EMappedFile.h"
+#include <fstream>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif//_WIN32
+namespace ecad {
+
+ECAD_INLINE EMappedFile::EMappedFile(std::string_view filename)
+{
+    Open(filename);
+}
+
+ECAD_INLINE EMappedFile::~EMappedFile()
+{
+    Close();
+}
+
+ECAD_INLINE bool EMappedFile::Open(std::string_view filename)
+{
+    Close();
+    std::string name(filename);
+#ifndef _WIN32
+    int fd = ::open(name.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (0 == ::fstat(fd, &st) && S_ISREG(st.st_mode)) {
+        m_size = static_cast<size_t>(st.st_size);
+        if (0 == m_size) m_open = true;
+        else if (auto addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0); addr != MAP_FAILED) {
+            ::madvise(addr, m_size, MADV_SEQUENTIAL);
+            m_addr = addr;
+            m_open = true;
+        }
+    }
+    if (not m_open) {
+        //not seekable or not mappable, read through
+        m_size = 0;
+        constexpr size_t chunk = 1 << 20;
+        for (ssize_t n = 0; ; m_size += n) {
+            m_buffer.resize(m_size + chunk);
+            n = ::read(fd, m_buffer.data() + m_size, chunk);
+            if (n <= 0) {
+                m_open = (0 == n);
+                break;
+            }
+        }
+        m_buffer.resize(m_size);
+    }
+    ::close(fd);
+#else
+    std::ifstream in(name, std::ios::binary);
+    if (not in.is_open()) return false;
+    m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    m_size = m_buffer.size();
+    m_open = true;
+#endif//_WIN32
+    if (not m_open) Close();
+    return m_open;
+}
+
+ECAD_INLINE void EMappedFile::Close()
+{
+#ifndef _WIN32
+    if (m_addr) ::munmap(m_addr, m_size);
+#endif//_WIN32
+    m_addr = nullptr;
+    m_size = 0;
+    m_open = false;
+    m_buffer = std::vector<char>{};
+}
+
+} // namespace ecad
@@ -0,0 +1,35 @@
+#pragma once
+#include "ECadCommon.h"
+#include <string_view>
+#include <vector>
+namespace ecad {
+
+///@brief read-only view of a whole file, memory mapped when possible,
+///       non-mappable inputs such as pipes are read into an owned buffer
+class ECAD_API EMappedFile
+{
+public:
+    EMappedFile() = default;
+    explicit EMappedFile(std::string_view filename);
+    ~EMappedFile();
+
+    EMappedFile(const EMappedFile &) = delete;
+    EMappedFile & operator= (const EMappedFile &) = delete;
+
+    bool Open(std::string_view filename);
+    void Close();
+
+    bool isOpen() const { return m_open; }
+    bool isMapped() const { return m_addr != nullptr; }
+    CPtr<char> Data() const { return isMapped() ? static_cast<CPtr<char>>(m_addr) : m_buffer.data(); }
+    size_t Size() const { return m_size; }
+    std::string_view View() const { return std::string_view(Data(), m_size); }
+
+private:
+    bool m_open{false};
+    Ptr<void> m_addr{nullptr};
+    size_t m_size{0};
+    std::vector<char> m_buffer;
+};
+
+} // namespace ecad
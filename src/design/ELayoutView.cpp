@@ -14,6 +14,7 @@ ECAD_SERIALIZATION_CLASS_EXPORT_IMP(ecad::ELayoutView)
 #include "utility/ELayout2CtmUtility.h"
 #include "utility/ELayoutModifier.h"
 #include "utility/ELayoutRetriever.h"
+#include "utility/EModelCache.h"
 
 #include "interface/IHierarchyObjCollection.h"
 #include "interface/IPadstackInstCollection.h"
@@ -333,7 +334,22 @@ ECAD_INLINE CPtr<IModel> ELayoutView::ExtractLayerCutModel(const ELayerCutModelE
         ECAD_TRACE("reuse exist layer cut model");
         return model;
     }
-    collection->AddModel(extraction::EGeometryModelExtraction::GenerateLayerCutModel(this, settings));
+
+    std::string cacheFile;
+    if (utils::EModelCache::isCacheable(EModelType::LayerCut) && not settings.cacheDir.empty()) {
+        cacheFile = utils::EModelCache::CacheFile(settings.cacheDir, EModelType::LayerCut,
+            utils::EModelCache::LayoutDigest(this), utils::EModelCache::SettingsDigest(settings));
+        if (auto cached = utils::EModelCache::Load(cacheFile, this); cached) {
+            ECAD_TRACE("load layer cut model from %1%", cacheFile);
+            collection->AddModel(std::move(cached));
+            return collection->FindModel(EModelType::LayerCut);
+        }
+    }
+
+    auto generated = extraction::EGeometryModelExtraction::GenerateLayerCutModel(this, settings);
+    if (generated && not cacheFile.empty() && not utils::EModelCache::Save(cacheFile, generated.get()))
+        ECAD_TRACE("failed to write model cache %1%", cacheFile);
+    collection->AddModel(std::move(generated));
     return collection->FindModel(EModelType::LayerCut);
 }
 
@@ -346,7 +362,24 @@ ECAD_INLINE CPtr<IModel> ELayoutView::ExtractThermalModel(const EThermalModelExt
         ECAD_TRACE("reuse exist %1% model", toString(modelType));
         return model;
     }
-    collection->AddModel(extraction::EThermalModelExtraction::GenerateThermalModel(this, settings));
+
+    std::string cacheFile;
+    if (utils::EModelCache::isCacheable(modelType) && not settings.cacheDir.empty()) {
+        cacheFile = utils::EModelCache::CacheFile(settings.cacheDir, modelType,
+            utils::EModelCache::LayoutDigest(this), utils::EModelCache::SettingsDigest(settings));
+        if (not settings.forceRebuild) {
+            if (auto cached = utils::EModelCache::Load(cacheFile, this); cached) {
+                ECAD_TRACE("load %1% model from %2%", toString(modelType), cacheFile);
+                collection->AddModel(std::move(cached));
+                return collection->FindModel(modelType);
+            }
+        }
+    }
+
+    auto generated = extraction::EThermalModelExtraction::GenerateThermalModel(this, settings);
+    if (generated && not cacheFile.empty() && not utils::EModelCache::Save(cacheFile, generated.get()))
+        ECAD_TRACE("failed to write model cache %1%", cacheFile);
+    collection->AddModel(std::move(generated));
     return collection->FindModel(modelType);
 }
 
@@ -373,6 +406,18 @@ ECAD_INLINE EPair<EFloat, EFloat> ELayoutView::RunThermalSimulation(const ETherm
     return sim.RunTransientSimulation(excitation);
 }
 
+ECAD_INLINE std::vector<EPair<EFloat, EFloat> > ELayoutView::RunThermalSweep(const EThermalStaticSimulationSetup & simulationSetup, const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures)
+{
+    temperatures.clear();
+    if (nullptr == simulationSetup.extractionSettings)
+        return std::vector<EPair<EFloat, EFloat> >(cases.size(), {invalidFloat, invalidFloat});
+    auto model = ExtractThermalModel(*simulationSetup.extractionSettings);
+    if (nullptr == model) return std::vector<EPair<EFloat, EFloat> >(cases.size(), {invalidFloat, invalidFloat});
+
+    simulation::EThermalSimulation sim(model, simulationSetup);
+    return sim.RunStaticSweep(cases, temperatures);
+}
+
 ECAD_INLINE void ELayoutView::Flatten(const EFlattenOption & option)
 {
     ECAD_UNUSED(option)//todo
@@ -110,6 +110,7 @@ public:
     ///Simulation
     EPair<EFloat, EFloat> RunThermalSimulation(const EThermalStaticSimulationSetup & simulationSetup, std::vector<EFloat> & temperatures) override;
     EPair<EFloat, EFloat> RunThermalSimulation(const EThermalTransientSimulationSetup & simulationSetup, const EThermalTransientExcitation & excitation) override;
+    std::vector<EPair<EFloat, EFloat> > RunThermalSweep(const EThermalStaticSimulationSetup & simulationSetup, const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) override;
 
     ///Flatten
     void Flatten(const EFlattenOption & option) override;
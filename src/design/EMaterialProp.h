@@ -103,6 +103,7 @@ public:
 
     //1x1-simple, 3x1-anisotropic, 3x3-tensor
     void GetDimensions(size_t & row, size_t & col) const override;
+    const std::vector<std::vector<EFloat> > & GetCoefficients() const override { return m_coefficients; }
     
 protected:
     ///Copy
@@ -18,20 +18,14 @@ ECAD_INLINE EGdsReader::~EGdsReader()
 
 ECAD_INLINE bool EGdsReader::operator() (std::string_view filename)
 {
-    // calculate file size 
-    std::ifstream in (filename.data());
-    if (not in.good()) return false;
-    std::streampos begin = in.tellg();
-    in.seekg(0, std::ios::end);
-    std::streampos end = in.tellg();
-    m_fileSize = (end-begin);
-    in.close();
 	// reset temporary data 
     m_status = EGdsRecords::UNKNOWN;
     Reset();
 	m_unsupportRecords.assign(EGdsRecords::UNKNOWN, 0); 
     // read gds 
-    bool res = EGdsParser(*this)(filename);
+    EGdsParser parser(*this);
+    bool res = parser(filename);
+    m_fileSize = parser.BytesRead();
 	PrintUnsupportedRecords();
 	return res; 
 }
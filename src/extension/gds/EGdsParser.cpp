@@ -1,8 +1,10 @@
 #include "EGdsParser.h"
 
 #include "extension/gds/EGdsFileIO.h"
+#include "basic/EMappedFile.h"
 #include <fstream>
 #include <cstring>
+#include <cmath>
 namespace ecad {
 
 namespace ext {
@@ -27,7 +29,11 @@ ECAD_INLINE EGdsParser::~EGdsParser()
 
 ECAD_INLINE bool EGdsParser::operator() (std::string_view filename)
 {
-    std::ifstream fp(filename.data());
+    EMappedFile file;
+    if (file.Open(filename))
+        return (*this)(file.Data(), file.Size());
+
+    std::ifstream fp(filename.data(), std::ios::binary);
     if (not fp.good()) {
         //todo, report error
         return false;
@@ -38,41 +44,35 @@ ECAD_INLINE bool EGdsParser::operator() (std::string_view filename)
     return res;
 }
 
-ECAD_INLINE bool EGdsParser::operator() (std::istream & fp)
+ECAD_INLINE bool EGdsParser::operator() (CPtr<char> data, size_t size)
 {
-	unsigned char * noByteArray;
-	int noRead;
-	int noBytes;
-	unsigned char * record{nullptr};
-    int indentAmount;
-	int recordType;
-	int dataType;
-	int expectedDataType;
-    EGdsRecords::EnumType enumRecordType;
-    EGdsData::EnumType enumDataType;
-    [[maybe_unused]] EGdsData::EnumType enumExpectedDataType;
-	int intKtr;
-	int dataKtr;
-	int exponentKtr;
-	[[maybe_unused]] int corruptKtr;
-	unsigned int displayInteger;
-#ifdef ECAD_EXT_GDS_DEBUG_MODE
-	unsigned int hexDisplayInteger;
-#endif 
-	char displayChar1;
-	char displayChar2;
-	int bitArray;
-	int realSign;
-	int realExponent;
-	unsigned long long realMantissaInt;
-	double realMantissaFloat;
-	double displayFloat;
-
-	/* start out with no indent */
-    indentAmount = 0;
+    auto begin = reinterpret_cast<const unsigned char *>(data);
+    auto iter = begin, end = begin + size;
+    while (end - iter >= 2) {
+        int noBytes = iter[0] * 256 + iter[1];
+        if (noBytes == 0) {//null padding after ENDLIB
+            iter += 2;
+            continue;
+        }
+        if (noBytes < 4 || end - iter < noBytes) {
+            //Error: It's a corrupt file!
+            break;
+        }
+        ParseRecord(iter + 2, noBytes - 2);
+        iter += noBytes;
+    }
+    m_bytesRead = iter - begin;
+    return true;
+}
 
+ECAD_INLINE bool EGdsParser::operator() (std::istream & fp)
+{
+    int noRead;
+    int noBytes;
+    const unsigned char * noByteArray;
+    m_bytesRead = 0;
     while (1){
-        noByteArray = (unsigned char*)Parse(fp, noRead, 2);
+        noByteArray = (const unsigned char*)Parse(fp, noRead, 2);
         if(noRead != 2){
             //Error: reached the end of the file!
             if(noRead == 1 && noByteArray[0] != 0){
@@ -80,173 +80,100 @@ ECAD_INLINE bool EGdsParser::operator() (std::istream & fp)
             }
             break;
         }
+        m_bytesRead += 2;
         noBytes = noByteArray[0] * 256 + noByteArray[1];
-
-        if(noBytes != 0){
-            record = (unsigned char*)Parse(fp, noRead, noBytes - 2);
-
-            if(noRead != noBytes - 2){
-                //Error: Couldn't read all of record!
-                //Error: It should have had %1% bytes, could only read %2% of them!, noBytes, noRead + 2
-                //Error: It's a corrupt file!
-                break;
-            }
+        if(noBytes == 0) continue;//null padding after ENDLIB
+        if(noBytes < 4){
+            //Error: It's a corrupt file!
+            break;
         }
 
-        recordType = record[0];
-        FindRecordType(recordType, enumRecordType, expectedDataType);
-
-        dataType = record[1];
-        FindDataType(dataType, enumDataType);
-
-        /* if it's a ENDSTR or ENDEL, subtract from indent */
-        if(enumRecordType == EGdsRecords::ENDSTR ||
-            enumRecordType == EGdsRecords::ENDEL){
-            if(indentAmount >= 2)
-                indentAmount -= 2;
+        auto record = (const unsigned char*)Parse(fp, noRead, noBytes - 2);
+        if(noRead != noBytes - 2){
+            //Error: Couldn't read all of record!
+            //Error: It should have had %1% bytes, could only read %2% of them!, noBytes, noRead + 2
+            //Error: It's a corrupt file!
+            break;
         }
+        m_bytesRead += noRead;
+        ParseRecord(record, noRead);
+    }
+    return true;
+}
 
-        if(expectedDataType != 0xffff && expectedDataType != dataType){
-            ///Error, todo
-        }
+ECAD_INLINE void EGdsParser::ParseRecord(const unsigned char * record, int noRead)
+{
+    int dataKtr;
+    int expectedDataType;
+    EGdsRecords::EnumType enumRecordType;
+    EGdsData::EnumType enumDataType;
 
-        if (expectedDataType == EGdsData::BIT_ARRAY){
-            std::vector<int> vBitArray;
-            vBitArray.reserve((noRead - 2) >> 1);
-            for(dataKtr = 2; dataKtr < noRead; dataKtr += 2){
-                /* use bit shifting instread of multiplication */
-                bitArray = (record[dataKtr] << 8) + record[dataKtr + 1];
-                vBitArray.push_back(bitArray);
-            }
-            m_reader.ReadBitArray(enumRecordType, enumDataType, vBitArray);
-        }
-        else if(expectedDataType == EGdsData::INTEGER_2){
-            std::vector<int> vInteger;
-            vInteger.reserve((noRead - 2) >> 1);
-            for(dataKtr = 2; dataKtr < noRead; dataKtr += 2){
-                displayInteger = record[dataKtr];
-                displayInteger <<= 8;
-                displayInteger += record[dataKtr + 1];
-                if (displayInteger & 0x8000){	/* negative number, 2's comp */
-                    displayInteger &= 0x7fff;
-                    displayInteger ^= 0x7fff;
-                    displayInteger +=  1;
-                    displayInteger *= -1;
-                } 
-                vInteger.push_back(displayInteger);
-            }
-            m_reader.ReadInteger2(enumRecordType, enumDataType, vInteger);
-        }
-		else if (expectedDataType == EGdsData::INTEGER_4){
-            std::vector<int> vInteger;
-            vInteger.reserve((noRead - 2) >> 1);
-            for(dataKtr = 2; dataKtr < noRead; dataKtr += 4){
-                displayInteger = 0;
-                for(intKtr = 0; intKtr < 4; intKtr++){
-                    displayInteger <<= 8;
-                    displayInteger += record[dataKtr + intKtr];
-                }
-                if(displayInteger & 0x80000000){	/* negative number, 2's comp */
-                    displayInteger &= 0x7fffffff;
-                    displayInteger ^= 0x7fffffff;
-                    displayInteger +=  1;
-                    displayInteger *= -1;
-                }
-                vInteger.push_back(displayInteger);
-            }
-            m_reader.ReadInteger4(enumRecordType, enumDataType, vInteger);
-        }
-        else if(expectedDataType == EGdsData::REAL_4){
-            std::vector<double> vFloat;
-            vFloat.reserve((noRead - 2) >> 2);
-            for (dataKtr = 2; dataKtr < noRead; dataKtr += 4){
-                realSign = record[dataKtr] & 0x80;
-                realExponent = (record[dataKtr] & 0x7f) - 64;
-                realMantissaInt = 0;
-                for (exponentKtr = 1; exponentKtr < 4; exponentKtr++){
-                    realMantissaInt <<= 8;
-                    realMantissaInt += record[dataKtr + exponentKtr];
-                }
-                realMantissaFloat = (double)realMantissaInt / std::pow(2, 24);
-                displayFloat = realMantissaFloat * std::pow(16, (float)realExponent);
-                if (realSign) displayFloat *= -1;
-                vFloat.push_back(displayFloat);
-            }
-            m_reader.ReadReal4(enumRecordType, enumDataType, vFloat);
-        }
-        else if (expectedDataType == EGdsData::REAL_8){
-            std::vector<double> vFloat;
-            vFloat.reserve((noRead - 2) >> 3);
-            for (dataKtr = 2; dataKtr < noRead; dataKtr += 8){
-                realSign = record[dataKtr] & 0x80;
-                realExponent = (record[dataKtr] & 0x7f) - 64;
-                realMantissaInt = 0;
-                for (exponentKtr = 1; exponentKtr < 8; exponentKtr++){
-                    realMantissaInt <<= 8;
-                    realMantissaInt += record[dataKtr + exponentKtr];
-                }
-                realMantissaFloat = (double)realMantissaInt / std::pow(2, 56);
-                displayFloat = realMantissaFloat * std::pow(16, (float)realExponent);
-                if (realSign) displayFloat *= -1;
-                vFloat.push_back(displayFloat);
-            }
-            m_reader.ReadReal8(enumRecordType, enumDataType, vFloat);
-        }
-        else if (expectedDataType == EGdsData::STRING){
-            std::string str;
-            str.reserve((noRead - 2) >> 1); 
-            for (dataKtr = 2; dataKtr < noRead; dataKtr += 2)
-            {
-                displayChar1 = record[dataKtr];
-                displayChar2 = record[dataKtr + 1];
+    FindRecordType(record[0], enumRecordType, expectedDataType);
+    FindDataType(record[1], enumDataType);
 
-                if (displayChar1 == '\0') break; /* quit early if encounter null character */
-                else if (!std::isprint (displayChar1)){
-                    displayChar1 = '.';
-                }
-                str.push_back(displayChar1);
+    if(expectedDataType != 0xffff && expectedDataType != record[1]){
+        ///Error, todo
+    }
 
-                if (displayChar2 == '\0') break; /* quit early if encounter null character */
-                else if (!std::isprint (displayChar2)){
-                    displayChar2 = '.';
-                }
-                str.push_back(displayChar2);
-            }
-            m_reader.ReadString(enumRecordType, enumDataType, str);
+    if (expectedDataType == EGdsData::BIT_ARRAY){
+        m_integers.clear();
+        for(dataKtr = 2; dataKtr + 1 < noRead; dataKtr += 2)
+            m_integers.push_back((record[dataKtr] << 8) + record[dataKtr + 1]);
+        m_reader.ReadBitArray(enumRecordType, enumDataType, m_integers);
+    }
+    else if(expectedDataType == EGdsData::INTEGER_2){
+        m_integers.clear();
+        for(dataKtr = 2; dataKtr + 1 < noRead; dataKtr += 2)
+            m_integers.push_back(static_cast<int16_t>((record[dataKtr] << 8) | record[dataKtr + 1]));
+        m_reader.ReadInteger2(enumRecordType, enumDataType, m_integers);
+    }
+    else if (expectedDataType == EGdsData::INTEGER_4){
+        m_integers.clear();
+        for(dataKtr = 2; dataKtr + 3 < noRead; dataKtr += 4){
+            uint32_t value = (uint32_t(record[dataKtr]) << 24) | (uint32_t(record[dataKtr + 1]) << 16) |
+                             (uint32_t(record[dataKtr + 2]) << 8) | uint32_t(record[dataKtr + 3]);
+            m_integers.push_back(static_cast<int32_t>(value));
         }
-        else
-        {
-            if (expectedDataType != EGdsData::NO_DATA){
-#ifdef ECAD_EXT_GDS_DEBUG_MODE
-                for (dataKtr = 2; dataKtr < noRead; dataKtr++){
-                    //"Error: 0x%02x # RAW(UNKNOWN)\n", record[dataKtr]);
-                }
-#endif 
+        m_reader.ReadInteger4(enumRecordType, enumDataType, m_integers);
+    }
+    else if(expectedDataType == EGdsData::REAL_4 || expectedDataType == EGdsData::REAL_8){
+        //excess-64 base-16 exponent with a 24 or 56 bits mantissa
+        const int bytes = expectedDataType == EGdsData::REAL_4 ? 4 : 8;
+        m_reals.clear();
+        for (dataKtr = 2; dataKtr + bytes - 1 < noRead; dataKtr += bytes){
+            bool realSign = record[dataKtr] & 0x80;
+            int realExponent = (record[dataKtr] & 0x7f) - 64;
+            unsigned long long realMantissaInt = 0;
+            for (int exponentKtr = 1; exponentKtr < bytes; exponentKtr++){
+                realMantissaInt <<= 8;
+                realMantissaInt += record[dataKtr + exponentKtr];
             }
-            else m_reader.ReadBeginEnd(enumRecordType); 
+            double value = std::ldexp(static_cast<double>(realMantissaInt), 4 * realExponent - 8 * (bytes - 1));
+            m_reals.push_back(realSign ? -value : value);
         }
-
-        /* if it's a BGNSTR or the beginning of an element, add to indent */
-        if( enumRecordType == EGdsRecords::BGNSTR ||
-            enumRecordType == EGdsRecords::BOUNDARY ||
-            enumRecordType == EGdsRecords::PATH ||
-            enumRecordType == EGdsRecords::SREF ||
-            enumRecordType == EGdsRecords::AREF ||
-            enumRecordType == EGdsRecords::TEXT ||
-            enumRecordType == EGdsRecords::TEXTNODE ||
-            enumRecordType == EGdsRecords::NODE ||
-            enumRecordType == EGdsRecords::BOX ){
-            indentAmount += ECAD_EXT_GDS_NO_SPACES_TO_INDENT;
+        if (bytes == 4) m_reader.ReadReal4(enumRecordType, enumDataType, m_reals);
+        else m_reader.ReadReal8(enumRecordType, enumDataType, m_reals);
+    }
+    else if (expectedDataType == EGdsData::STRING){
+        m_string.clear();
+        for (dataKtr = 2; dataKtr < noRead; ++dataKtr){
+            char displayChar = record[dataKtr];
+            if (displayChar == '\0') break; /* quit early if encounter null character */
+            m_string.push_back(std::isprint(static_cast<unsigned char>(displayChar)) ? displayChar : '.');
         }
-		else
-		{
+        m_reader.ReadString(enumRecordType, enumDataType, m_string);
+    }
+    else
+    {
+        if (expectedDataType != EGdsData::NO_DATA){
 #ifdef ECAD_EXT_GDS_DEBUG_MODE
-			/* if it was a NULL record */
+            for (dataKtr = 2; dataKtr < noRead; dataKtr++){
+                //"Error: 0x%02x # RAW(UNKNOWN)\n", record[dataKtr]);
+            }
 #endif 
-		}
-	}
-
-	return true;
+        }
+        else m_reader.ReadBeginEnd(enumRecordType); 
+    }
 }
 
 ECAD_INLINE const char * EGdsParser::Parse(std::istream & fp, int & noRead, size_t n)
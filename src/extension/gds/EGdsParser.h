@@ -15,11 +15,19 @@ public:
     EGdsParser(EGdsReader & reader);
     virtual ~EGdsParser();
 
+    ///@brief parses the memory mapped file, falls back to the stream parser if the file can not be loaded
     bool operator() (std::string_view filename);
     bool operator() (std::istream & fp);
+    ///@brief parses records in place from an in-memory gds image
+    bool operator() (CPtr<char> data, size_t size);
+
+    ///@brief bytes consumed by the last parse
+    size_t BytesRead() const { return m_bytesRead; }
 
 protected:
     CPtr<char> Parse(std::istream & fp, int & noRead, size_t n);
+    ///@brief record points to the record type byte, size is the record length without the 2 length bytes
+    void ParseRecord(const unsigned char * record, int size);
     void FindRecordType(int numeric, EGdsRecords::EnumType & recordType, int & expectedDataType);
     void FindDataType(int numeric, EGdsData::EnumType & dataType);
 
@@ -29,6 +37,11 @@ protected:
     Ptr<char> m_bptr{nullptr};
     size_t m_bcap;//buffer capacity
     size_t m_blen;//current buffer size, from m_bptr to m_buffer + m_bcap
+    size_t m_bytesRead{0};
+    //reused record data
+    std::vector<int> m_integers;
+    std::vector<double> m_reals;
+    std::string m_string;
 };
 
 }//namespace gds   
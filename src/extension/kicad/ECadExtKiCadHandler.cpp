@@ -64,9 +64,9 @@ ECAD_INLINE void ECadExtKiCadHandler::ExtractNode(const Tree & node)
 ECAD_INLINE void ECadExtKiCadHandler::ExtractLayer(const Tree & node)
 {
     for (const auto & sub : node.branches) {   
-        EIndex id = std::stoi(sub.value);         
-        auto name = sub.branches.at(0).value;
-        auto & layer = m_kicad->AddLayer(id, name);
+        EIndex id{invalidIndex};
+        GetValue(sub.value, id);
+        auto & layer = m_kicad->AddLayer(id, std::string(sub.branches.at(0).value));
         layer.SetGroup(sub.branches.at(1).value);
         if (sub.branches.size() > 2)
             layer.attr = sub.branches.at(2).value;
@@ -106,15 +106,14 @@ ECAD_INLINE void ECadExtKiCadHandler::ExtractStackup(const Tree & node)
 ECAD_INLINE void ECadExtKiCadHandler::ExtractNet(const Tree & node)
 {
     EIndex netId{invalidIndex};
-    auto & netName = node.branches.at(1).value;
     GetValue(node.branches, netId);
-    m_kicad->AddNet(netId, netName);
+    m_kicad->AddNet(netId, std::string(node.branches.at(1).value));
 }
 
 ECAD_INLINE void ECadExtKiCadHandler::ExtractFootprint(const Tree & node)
 {
     auto iter = node.branches.begin();
-    auto & comp = m_kicad->AddComponent(iter->value);
+    auto & comp = m_kicad->AddComponent(std::string(iter->value));
     m_current.comp = &comp;
     for (iter = std::next(iter); iter != node.branches.end(); ++iter) {
         const auto & branches = iter->branches;
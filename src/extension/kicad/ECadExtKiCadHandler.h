@@ -2,6 +2,8 @@
 #include "basic/ECadCommon.h"
 #include "EKiCadObjects.h"
 #include "EKiCadParser.h"
+#include <charconv>
+#include <cstdlib>
 namespace ecad {
 
 class INet;
@@ -46,16 +48,19 @@ private:
     void CreateEcadNets(Ptr<ILayoutView> layout);
     void CreateLayoutBoundary(Ptr<ILayoutView> layout);
     
-    template <typename... Args>
-    static void GetValue(const std::string & s, Args & ...args)
+    template <typename T>
+    static void GetValue(std::string_view s, T & t)
     {
-        static std::stringstream ss;
-        ss.str(s); ss.clear();
-        (ss >> ... >> args);
+        if constexpr (std::is_same_v<T, std::string>) t.assign(s);
+        else if constexpr (std::is_integral_v<T>) std::from_chars(s.data(), s.data() + s.size(), t);
+        else {
+            static_assert(std::is_floating_point_v<T>, "unsupported kicad value type");
+            t = static_cast<T>(std::strtod(s.data(), nullptr));//atoms are null-terminated
+        }
     }
 
     template <typename... Args>
-    static void GetValue(std::vector<Tree>::const_iterator iter, Args & ...args)
+    static void GetValue(Branches::const_iterator iter, Args & ...args)
     {
         ([&]{
             GetValue(iter->value, args);
@@ -64,7 +69,7 @@ private:
     }
 
     template <typename... Args>
-    static void TryGetValue(std::vector<Tree>::const_iterator iter, std::vector<Tree>::const_iterator end, Args & ...args)
+    static void TryGetValue(Branches::const_iterator iter, Branches::const_iterator end, Args & ...args)
     {
         ([&]{
             if (iter != end) {
@@ -75,13 +80,13 @@ private:
     }
 
     template <typename... Args>
-    static void GetValue(const std::vector<Tree> & branches, Args & ...args)
+    static void GetValue(const Branches & branches, Args & ...args)
     {
         GetValue(branches.begin(), args...);
     }
 
     template <typename... Args>
-    static void TryGetValue(const std::vector<Tree> & branches, Args & ...args)
+    static void TryGetValue(const Branches & branches, Args & ...args)
     {
         TryGetValue(branches.begin(), branches.end(), args...);
     }
@@ -92,7 +97,7 @@ private:
     Ptr<IDatabase> m_database{nullptr};
 
     //func lut
-    std::unordered_map<std::string, std::function<void(const Tree &)>> m_functions;
+    std::unordered_map<std::string_view, std::function<void(const Tree &)>> m_functions;
     
     // kicad-ecad lut
     struct Lut
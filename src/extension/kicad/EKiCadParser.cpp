@@ -1,116 +1,136 @@
 #include "EKiCadParser.h"
 #include "EKiCadObjects.h"
+#include "basic/EMappedFile.h"
+#include <algorithm>
+#include <cstring>
 namespace ecad::ext::kicad {
 
+namespace detail {
+
+ECAD_ALWAYS_INLINE bool isWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+ECAD_ALWAYS_INLINE bool isDelimiter(char c)
+{
+    return isWhitespace(c) || c == '(' || c == ')';
+}
+
+} // namespace detail
+
 ECAD_INLINE EKiCadParser::EKiCadParser()
 {
 }
 
 ECAD_INLINE bool EKiCadParser::operator() (std::string_view filename, Tree & tree)
 {
-    std::ifstream in(filename.data());
-    if (not in.good()) {
+    EMappedFile file(filename);
+    if (not file.isOpen()) {
         //todo, report error
         return false;
     }
-
-    tree = ReadTree(in);
-    return true;
+    //atoms are interned, the file is not needed after parsing
+    return operator()(file.Data(), file.Size(), tree);
 }
 
-Tree EKiCadParser::ReadTree(std::istream & in)
+ECAD_INLINE bool EKiCadParser::operator() (CPtr<char> data, size_t size, Tree & tree)
 {
-    char c;
-    ReadUntil(in, '(');
-    ReadWhitespace(in);
-    auto t = Tree{ReadNodeName(in), {}};
-    for(;;) {
-        ReadWhitespace(in);
-        auto b = in.peek();
-        if (b == EOF) break;
-        if (b == ')') {
-            in.get(c);
-            break;
+    Clear();
+    m_atoms.reserve(size / 32);
+
+    auto curr = data, end = data + size;
+    auto readAtom = [&] {
+        auto begin = curr;
+        while (curr != end && not detail::isDelimiter(*curr)) ++curr;
+        return Intern(std::string_view(begin, curr - begin));
+    };
+    auto closeNode = [&] {
+        auto frame = m_frames.back(); m_frames.pop_back();
+        auto & node = m_stack[frame];
+        auto count = m_stack.size() - frame - 1;
+        node.branches = Branches(Allocate(m_stack.data() + frame + 1, count), count);
+        m_stack.resize(frame + 1);
+    };
+
+    curr = std::find(curr, end, '(');
+    if (curr == end) return false;
+    while (curr != end) {
+        auto c = *curr;
+        if (detail::isWhitespace(c)) { ++curr; continue; }
+        if (c == '(') {
+            ++curr;
+            while (curr != end && detail::isWhitespace(*curr)) ++curr;
+            m_frames.emplace_back(m_stack.size());
+            m_stack.emplace_back(Tree{readAtom(), {}});
         }
-        if (b == '(') {
-            t.branches.emplace_back(ReadTree(in));
-            continue;
+        else if (c == ')') {
+            ++curr;
+            closeNode();
+            if (m_frames.empty()) break;
         }
-        if (b == '"') {
-            in.get(c);
-            t.branches.emplace_back(ReadQuotedString(in));
-            in.get(c);
-            continue;
+        else if (c == '"') {
+            auto begin = ++curr;
+            while (curr != end && *curr != '"') {
+                if (*curr == '\\' && curr + 1 != end) ++curr;
+                ++curr;
+            }
+            m_stack.emplace_back(Tree{Intern(std::string_view(begin, curr - begin)), {}});
+            if (curr != end) ++curr;
         }
-        t.branches.emplace_back(ReadString(in));
+        else m_stack.emplace_back(Tree{readAtom(), {}});
     }
-    return t;
-}
+    //unterminated expressions are closed at the end of input
+    while (not m_frames.empty()) closeNode();
 
-Tree EKiCadParser::ReadString(std::istream & in)
-{
-    std::string s;
-    for (;;) {
-        auto b = in.peek();
-        if (b == '\t' || b == '\n' || b == '\r' || b == ')' || b == ' ')
-            break;
-        char c;
-        in.get(c);
-        s.push_back(c);
-    }
-    return Tree{s, {}};    
+    tree = m_stack.front();
+    m_stack.clear();
+    m_totalNodes += 1;
+    return true;
 }
 
-Tree EKiCadParser::ReadQuotedString(std::istream & in)
+ECAD_INLINE void EKiCadParser::Clear()
 {
-    char c;
-    std::string s;
-    // s.push_back('"');
-    auto a = in.peek();
-    for (;;) {
-        auto b = in.peek();
-        if (b == '"' && a != '\\')
-            break;
-        in.get(c);
-        s.push_back(c);
-        a = b;
-    }
-    // s.push_back('"');
-    return Tree{s, {}};
+    m_totalNodes = 0;
+    m_nodes.clear();
+    m_chars.clear();
+    m_atoms.clear();
+    m_stack.clear();
+    m_frames.clear();
 }
 
-std::string EKiCadParser::ReadNodeName(std::istream & in)
+ECAD_INLINE std::string_view EKiCadParser::Intern(std::string_view atom)
 {
-    char c;
-    std::string s;
-    for(;;) {
-        auto b = in.peek();
-        if (b == '\t' || b == '\n' || b == '\r' || b == ' ' || b == ')') break;
-        in.get(c);
-        s.push_back(c);
-    }
-    return s;
-}
+    if (auto iter = m_atoms.find(atom); iter != m_atoms.cend()) return *iter;
 
-bool EKiCadParser::ReadUntil(std::istream & in, char c)
-{
-    char input;
-    while(in.get(input)) {
-        if (input == c)
-            return false;
+    auto size = atom.size() + 1;
+    if (m_chars.empty() || m_chars.back().used + size > m_chars.back().capacity) {
+        auto & block = m_chars.emplace_back();
+        block.capacity = std::max(atomBlockSize, size);
+        block.data.reset(new char[block.capacity]);
     }
-    return true;
+    auto & block = m_chars.back();
+    auto str = block.data.get() + block.used;
+    std::memcpy(str, atom.data(), atom.size());
+    str[atom.size()] = '\0';
+    block.used += size;
+    return *m_atoms.emplace(str, atom.size()).first;
 }
 
-void EKiCadParser::ReadWhitespace(std::istream & in)
+ECAD_INLINE CPtr<Tree> EKiCadParser::Allocate(CPtr<Tree> nodes, size_t size)
 {
-    char c;
-    for (;;) {
-        auto b = in.peek();
-        if (b != '\t' && b != '\n' && b != '\r' && b != ' ')
-            break;
-        in.get(c);
+    if (0 == size) return nullptr;
+    if (m_nodes.empty() || m_nodes.back().used + size > m_nodes.back().capacity) {
+        auto & block = m_nodes.emplace_back();
+        block.capacity = std::max(nodeBlockSize, size);
+        block.data.reset(new Tree[block.capacity]);
     }
+    auto & block = m_nodes.back();
+    auto range = block.data.get() + block.used;
+    std::copy(nodes, nodes + size, range);
+    block.used += size;
+    m_totalNodes += size;
+    return range;
 }
 
-} // namespace ecad::ext::kicad
\ No newline at end of file
+} // namespace ecad::ext::kicad
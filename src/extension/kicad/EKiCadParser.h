@@ -1,31 +1,95 @@
 #pragma once
 #include "basic/ECadCommon.h"
+#include <unordered_set>
 #include <string_view>
-#include <istream>
+#include <stdexcept>
+#include <vector>
 
 namespace ecad::ext::kicad {
 
+struct Tree;
+
+///@brief contiguous range of child nodes in the parser arena
+class Branches
+{
+public:
+    using const_iterator = CPtr<Tree>;
+    Branches() = default;
+    Branches(CPtr<Tree> begin, size_t size) : m_begin(begin), m_size(size) {}
+
+    const_iterator begin() const { return m_begin; }
+    const_iterator end() const;
+    size_t size() const { return m_size; }
+    bool empty() const { return 0 == m_size; }
+
+    const Tree & front() const;
+    const Tree & back() const;
+    const Tree & operator[] (size_t i) const;
+    const Tree & at(size_t i) const;
+
+private:
+    CPtr<Tree> m_begin{nullptr};
+    size_t m_size{0};
+};
+
+///@brief s-expression node, the value is an interned, null-terminated atom
 struct Tree
 {
-    std::string value;
-    std::vector<Tree> branches;
+    std::string_view value;
+    Branches branches;
 };
 
+ECAD_ALWAYS_INLINE Branches::const_iterator Branches::end() const { return m_begin + m_size; }
+ECAD_ALWAYS_INLINE const Tree & Branches::front() const { return m_begin[0]; }
+ECAD_ALWAYS_INLINE const Tree & Branches::back() const { return m_begin[m_size - 1]; }
+ECAD_ALWAYS_INLINE const Tree & Branches::operator[] (size_t i) const { return m_begin[i]; }
+ECAD_ALWAYS_INLINE const Tree & Branches::at(size_t i) const
+{
+    if (i >= m_size) throw std::out_of_range("kicad tree branch index out of range");
+    return m_begin[i];
+}
+
+///@brief s-expression parser, the tree refers to nodes and atoms owned by the parser
+///       and stays valid until the parser is destroyed or parses again
 class ECAD_API EKiCadParser
 {
 public:
     EKiCadParser();
     virtual ~EKiCadParser() = default;
 
+    EKiCadParser(const EKiCadParser &) = delete;
+    EKiCadParser & operator= (const EKiCadParser &) = delete;
+
     bool operator() (std::string_view filename, Tree & tree);
+    ///@brief parses the first top-level expression of an in-memory text
+    bool operator() (CPtr<char> data, size_t size, Tree & tree);
+
+    size_t TotalNodes() const { return m_totalNodes; }
+    size_t TotalAtoms() const { return m_atoms.size(); }
 
 protected:
-    Tree ReadTree(std::istream & in);
-    Tree ReadString(std::istream & in);
-    Tree ReadQuotedString(std::istream & in);
-    std::string ReadNodeName(std::istream & in);
-    bool ReadUntil(std::istream & in, char c);
-    void ReadWhitespace(std::istream & in);
+    void Clear();
+    std::string_view Intern(std::string_view atom);
+    CPtr<Tree> Allocate(CPtr<Tree> nodes, size_t size);
+
+private:
+    static constexpr size_t nodeBlockSize = 4096;
+    static constexpr size_t atomBlockSize = 64 * 1024;
+
+    template <typename T>
+    struct Block
+    {
+        std::unique_ptr<T[]> data;
+        size_t used{0};
+        size_t capacity{0};
+    };
+
+    size_t m_totalNodes{0};
+    std::vector<Block<Tree> > m_nodes;
+    std::vector<Block<char> > m_chars;
+    std::unordered_set<std::string_view> m_atoms;
+    std::vector<Tree> m_stack;//open nodes followed by their parsed children
+    std::vector<size_t> m_frames;
 };
 
-}//namespace ecad::ext::kicad
\ No newline at end of file
+}//namespace ecad::ext::kicad
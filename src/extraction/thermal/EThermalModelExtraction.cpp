@@ -19,6 +19,18 @@ using namespace ecad::model;
 using namespace ecad::utils;
 using namespace generic::geometry;
 
+namespace detail {
+
+template <typename Triangulation>
+ECAD_INLINE void GetTriangleCenters(const Triangulation & triangulation, std::vector<EPoint2D> & centers)
+{
+    centers.resize(triangulation.triangles.size());
+    for (size_t it = 0; it < centers.size(); ++it)
+        centers[it] = tri::TriangulationUtility<EPoint2D>::GetCenter(triangulation, it).Cast<ECoord>();
+}
+
+} // namespace detail
+
 ECAD_INLINE UPtr<IModel> EThermalModelExtraction::GenerateThermalModel(Ptr<ILayoutView> layout, const EThermalModelExtractionSettings & settings)
 {
     if (auto gridSettings = dynamic_cast<CPtr<EGridThermalModelExtractionSettings>>(&settings); gridSettings)
@@ -224,16 +236,20 @@ ECAD_INLINE UPtr<IModel> EThermalModelExtraction::GeneratePrismThermalModel(Ptr<
     model::utils::ELayerCutModelQuery query(compact);
     const auto & powerBlocks = compact->GetAllPowerBlocks();
     std::unordered_map<size_t, std::unordered_map<size_t, size_t> > templateIdMap;//[layer, [tempId, eleId]]
+    std::unordered_map<CPtr<void>, std::vector<EPoint2D> > templateCenters;//layers sharing a template share the triangle centers
+    std::vector<size_t> pids;
 
     auto buildOnePrismLayer = [&](size_t index) {
         auto & prismLayer = model->layers.at(index);
         auto & idMap = templateIdMap.emplace(prismLayer.id, std::unordered_map<size_t, size_t>{}).first->second;    
         auto triangulation = model->GetLayerPrismTemplate(index);
+        ECAD_ASSERT(compact->hasPolygon(prismLayer.id))
+        auto & ctPoints = templateCenters[triangulation.get()];
+        if (ctPoints.empty()) detail::GetTriangleCenters(*triangulation, ctPoints);
+        query.SearchPolygons(prismLayer.id, ctPoints, pids, settings.threads);
         for (size_t it = 0; it < triangulation->triangles.size(); ++it) {
-            ECAD_ASSERT(compact->hasPolygon(prismLayer.id))
-            auto ctPoint = tri::TriangulationUtility<EPoint2D>::GetCenter(*triangulation, it).Cast<ECoord>();
-            auto pid = query.SearchPolygon(prismLayer.id, ctPoint);
-            if (pid == invalidIndex) continue;;
+            auto pid = pids.at(it);
+            if (pid == invalidIndex) continue;
             if (fluidMaterials.count(compact->GetMaterialId(pid))) continue;
             if (EMaterialId::noMaterial == compact->GetMaterialId(pid)) continue;
 
@@ -245,7 +261,7 @@ ECAD_INLINE UPtr<IModel> EThermalModelExtraction::GeneratePrismThermalModel(Ptr<
             if (iter != powerBlocks.cend() &&
                 prismLayer.id == compact->GetLayerIndexByHeight(iter->second.range.high)) {
                 auto area = tri::TriangulationUtility<EPoint2D>::GetTriangleArea(*triangulation, it);
-                ele.powerRatio = area / compact->GetAllPolygonData().at(pid).Area();
+                ele.powerRatio = area / query.GetPolygonArea(pid);
                 ele.powerScenario = iter->second.scen;
                 ele.powerLut = iter->second.power;
             }
@@ -308,8 +324,8 @@ ECAD_INLINE UPtr<IModel> EThermalModelExtraction::GeneratePrismThermalModel(Ptr<
     }
         
     if (not settings.workDir.empty() && settings.meshSettings.dumpMeshFile) { 
-        auto meshFile = settings.workDir + ECAD_SEPS + "mesh.vtk";
-        io::GenerateVTKFile<EFloat>(meshFile, *model);
+        auto meshFile = settings.workDir + ECAD_SEPS + "mesh.vtu";
+        io::GenerateVTUFile<EFloat>(meshFile, *model);
     }
 
     return std::unique_ptr<IModel>(model);
@@ -394,16 +410,20 @@ ECAD_INLINE UPtr<IModel> EThermalModelExtraction::GenerateStackupPrismThermalMod
     model::utils::ELayerCutModelQuery query(compact);
     const auto & powerBlocks = compact->GetAllPowerBlocks();
     std::unordered_map<size_t, std::unordered_map<size_t, size_t> > templateIdMap;//[layer, [tempId, eleId]]
+    std::unordered_map<CPtr<void>, std::vector<EPoint2D> > templateCenters;//layers sharing a template share the triangle centers
+    std::vector<size_t> pids;
 
     auto buildOnePrismLayer = [&](size_t index) {
         auto & prismLayer = model->layers.at(index);
         auto & idMap = templateIdMap.emplace(prismLayer.id, std::unordered_map<size_t, size_t>{}).first->second;    
         auto triangulation = model->GetLayerPrismTemplate(index);
+        ECAD_ASSERT(compact->hasPolygon(prismLayer.id))
+        auto & ctPoints = templateCenters[triangulation.get()];
+        if (ctPoints.empty()) detail::GetTriangleCenters(*triangulation, ctPoints);
+        query.SearchPolygons(prismLayer.id, ctPoints, pids, settings.threads);
         for (size_t it = 0; it < triangulation->triangles.size(); ++it) {
-            ECAD_ASSERT(compact->hasPolygon(prismLayer.id))
-            auto ctPoint = tri::TriangulationUtility<EPoint2D>::GetCenter(*triangulation, it).Cast<ECoord>();
-            auto pid = query.SearchPolygon(prismLayer.id, ctPoint);
-            if (pid == invalidIndex) continue;;
+            auto pid = pids.at(it);
+            if (pid == invalidIndex) continue;
             if (fluidMaterials.count(compact->GetMaterialId(pid))) continue;
             if (EMaterialId::noMaterial == compact->GetMaterialId(pid)) continue;
 
@@ -415,7 +435,7 @@ ECAD_INLINE UPtr<IModel> EThermalModelExtraction::GenerateStackupPrismThermalMod
             if (iter != powerBlocks.cend() &&
                 prismLayer.id == compact->GetLayerIndexByHeight(iter->second.range.high)) {
                 auto area = tri::TriangulationUtility<EPoint2D>::GetTriangleArea(*triangulation, it);
-                ele.powerRatio = area / compact->GetAllPolygonData().at(pid).Area();
+                ele.powerRatio = area / query.GetPolygonArea(pid);
                 ele.powerScenario = iter->second.scen;
                 ele.powerLut = iter->second.power;
             }
@@ -471,8 +491,8 @@ ECAD_INLINE UPtr<IModel> EThermalModelExtraction::GenerateStackupPrismThermalMod
     }
         
     if (not settings.workDir.empty() && settings.meshSettings.dumpMeshFile) { 
-        auto meshFile = settings.workDir + ECAD_SEPS + "mesh.vtk";
-        io::GenerateVTKFile<EFloat>(meshFile, *model);
+        auto meshFile = settings.workDir + ECAD_SEPS + "mesh.vtu";
+        io::GenerateVTUFile<EFloat>(meshFile, *model);
     }
     return std::unique_ptr<IModel>(model);
 }
@@ -127,6 +127,8 @@ public:
     ///Thermal Simulation
     virtual EPair<EFloat, EFloat> RunThermalSimulation(const EThermalStaticSimulationSetup & simulationSetup, std::vector<EFloat> & temperatures) = 0;
     virtual EPair<EFloat, EFloat> RunThermalSimulation(const EThermalTransientSimulationSetup & simulationSetup, const EThermalTransientExcitation & excitation) = 0;
+    ///@brief extracts and builds the network once and solves all cases, returns [minT, maxT] per case and the monitor temperatures per case
+    virtual std::vector<EPair<EFloat, EFloat> > RunThermalSweep(const EThermalStaticSimulationSetup & simulationSetup, const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) = 0;
 
     ///Mapping
     virtual void Map(CPtr<ILayerMap> lyrMap) = 0;
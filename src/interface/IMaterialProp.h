@@ -53,6 +53,8 @@ public:
 
     //1x1-simple, 3x1-anisotropic, 3x3-tensor
     virtual void GetDimensions(size_t & row, size_t & col) const = 0;
+    ///@brief ascending coefficients of each component, 1, 3 or 9 sets for simple, anisotropic or tensor
+    virtual const std::vector<std::vector<EFloat> > & GetCoefficients() const = 0;
 };
 
 }//namespace ecad
@@ -1,5 +1,6 @@
 #include "ELayerCutModelQuery.h"
 #include "model/geometry/ELayerCutModel.h"
+#include "generic/thread/ThreadPool.hpp"
 
 namespace ecad {
 namespace model {
@@ -7,6 +8,10 @@ namespace utils {
 ECAD_INLINE ELayerCutModelQuery::ELayerCutModelQuery(CPtr<ELayerCutModel> model)
  : m_model(model)
 {
+    m_areas.resize(m_model->m_polygons.size());
+    for (size_t i = 0; i < m_areas.size(); ++i)
+        m_areas[i] = m_model->m_polygons.at(i).Area();
+
     const auto & layerPolygons = m_model->m_lyrPolygons;
     for (size_t lyr = 0; lyr < m_model->TotalLayers(); ++lyr) {
         if (lyr > 0 && layerPolygons.at(lyr) == layerPolygons.at(lyr - 1))
@@ -22,20 +27,53 @@ ECAD_INLINE ELayerCutModelQuery::ELayerCutModelQuery(CPtr<ELayerCutModel> model)
 }
 
 ECAD_INLINE size_t ELayerCutModelQuery::SearchPolygon(size_t layer, const EPoint2D & pt) const
+{
+    std::vector<RtVal> buffer;
+    return SearchPolygon(layer, pt, buffer);
+}
+
+ECAD_INLINE void ELayerCutModelQuery::SearchPolygons(size_t layer, const std::vector<EPoint2D> & pts, std::vector<size_t> & pids, size_t threads) const
+{
+    pids.assign(pts.size(), invalidIndex);
+    if (not m_model->hasPolygon(layer)) return;
+
+    //the rtrees are only read here, each chunk writes its own range of results
+    const size_t chunks = (pts.size() + pointChunkSize - 1) / pointChunkSize;
+    auto searchChunk = [&](size_t chunk) {
+        std::vector<RtVal> buffer;
+        auto end = std::min((chunk + 1) * pointChunkSize, pts.size());
+        for (size_t i = chunk * pointChunkSize; i < end; ++i)
+            pids[i] = SearchPolygon(layer, pts[i], buffer);
+    };
+    if (threads > 1 && chunks > 1) {
+        generic::thread::ThreadPool pool(std::min(threads, chunks));
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+            pool.Submit(std::bind(searchChunk, chunk));
+    }
+    else {
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+            searchChunk(chunk);
+    }
+}
+
+ECAD_INLINE size_t ELayerCutModelQuery::SearchPolygon(size_t layer, const EPoint2D & pt, std::vector<RtVal> & buffer) const
 {
     if (not m_model->hasPolygon(layer)) return invalidIndex;
 
-    std::vector<RtVal> results;
-    m_rtrees.at(layer)->query(boost::geometry::index::intersects(EBox2D(pt, pt)), std::back_inserter(results));
-    if (results.empty()) return invalidIndex;
+    buffer.clear();
+    m_rtrees.at(layer)->query(boost::geometry::index::intersects(EBox2D(pt, pt)), std::back_inserter(buffer));
+    if (buffer.empty()) return invalidIndex;
+
+    //test candidates from the smallest area up, the first containing one is the result
+    auto cmp = [&](const RtVal & v1, const RtVal & v2) {
+        return m_areas[v1.second] < m_areas[v2.second] || (m_areas[v1.second] == m_areas[v2.second] && v1.second < v2.second);
+    };
+    std::sort(buffer.begin(), buffer.end(), cmp);
     const auto & polygons = m_model->m_polygons;
-    auto cmp = [&](auto i1, auto i2){ return polygons.at(i1).Area() > polygons.at(i2).Area(); };
-    std::priority_queue<size_t, std::vector<size_t>, decltype(cmp)> pq(cmp);
-    for (const auto & result : results) {
-        if (generic::geometry::Contains(polygons.at(result.second), pt))
-            pq.emplace(result.second);
+    for (const auto & candidate : buffer) {
+        if (generic::geometry::Contains(polygons.at(candidate.second), pt))
+            return candidate.second;
     }
-    if (not pq.empty()) return pq.top();
     return invalidIndex;
 }
 
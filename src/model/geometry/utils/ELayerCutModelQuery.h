@@ -15,12 +15,22 @@ public:
     explicit ELayerCutModelQuery(CPtr<ELayerCutModel> model);
     virtual ~ELayerCutModelQuery() = default;
 
+    ///@brief returns the smallest polygon on the layer containing the point, invalidIndex if not found
     size_t SearchPolygon(size_t layer, const EPoint2D & pt) const;
-    
+    ///@brief batch version of SearchPolygon, pids[i] is the result of pts[i], independent of the thread count
+    void SearchPolygons(size_t layer, const std::vector<EPoint2D> & pts, std::vector<size_t> & pids, size_t threads = 1) const;
+
+    EFloat GetPolygonArea(size_t pid) const { return m_areas.at(pid); }
+
+protected:
+    size_t SearchPolygon(size_t layer, const EPoint2D & pt, std::vector<RtVal> & buffer) const;
+
 protected:
+    static constexpr size_t pointChunkSize = 4096;
     CPtr<ELayerCutModel> m_model{nullptr};
+    std::vector<EFloat> m_areas;
     mutable std::unordered_map<size_t, std::shared_ptr<Rtree> > m_rtrees;
 };
 } // namespace utils
 } // namespace model
-} // namespace ecad
\ No newline at end of file
+} // namespace ecad
@@ -177,6 +177,8 @@ public:
     void SetLayerPrismTemplate(size_t layer, SPtr<PrismTemplate> prismTemplate);
     SPtr<PrismTemplate> GetLayerPrismTemplate(size_t layer) const;
 
+    void SetLayoutView(CPtr<ILayoutView> layout) { m_layout = layout; }
+    CPtr<ILayoutView> GetLayoutView() const { return m_layout; }
     CPtr<IMaterialDefCollection> GetMaterialLibrary() const;
 
     void AddBlockBC(EOrientation orient, EBox2D block, EThermalBoundaryCondition bc);
@@ -194,7 +196,7 @@ public:
     size_t TotalLineElements() const;
     size_t TotalPrismElements() const;
     size_t GlobalIndex(size_t lyrIndex, size_t eleIndex) const;
-    std::pair<size_t, size_t> PrismLocalIndex(size_t index) const;//[lyrIndex, eleIndex]
+    std::pair<size_t, size_t> PrismLocalIndex(size_t index) const;//[lyrIndex, eleIndex], O(log(layers))
     size_t LineLocalIndex(size_t index) const;
     bool isPrima(size_t index) const;
 
@@ -269,8 +271,10 @@ ECAD_ALWAYS_INLINE size_t EPrismThermalModel::GlobalIndex(size_t lyrIndex, size_
 
 ECAD_ALWAYS_INLINE std::pair<size_t, size_t> EPrismThermalModel::PrismLocalIndex(size_t index) const
 {
-    size_t lyrIdex = 0;
-    while (not (m_indexOffset[lyrIdex] <= index && index < m_indexOffset[lyrIdex + 1])) lyrIdex++;
+    ECAD_ASSERT(isPrima(index))
+    //last layer starting at or before index, empty layers share their offset with the next one and are skipped
+    auto iter = std::upper_bound(m_indexOffset.begin(), m_indexOffset.end(), index);
+    size_t lyrIdex = std::distance(m_indexOffset.begin(), iter) - 1;
     return std::make_pair(lyrIdex, index - m_indexOffset[lyrIdex]);
 }
 
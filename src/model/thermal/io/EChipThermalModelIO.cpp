@@ -1,8 +1,18 @@
 #include "model/thermal/io/EChipThermalModelIO.h"
+#include "basic/EMappedFile.h"
+#include "EDataMgr.h"
 
+#include "generic/thread/ThreadPool.hpp"
 #include "generic/tools/StringHelper.hpp"
 #include "generic/tools/FileSystem.hpp"
 #include "generic/tools/Format.hpp"
+#ifdef ECAD_ZLIB_SUPPORT
+#include <zlib.h>
+#endif//ECAD_ZLIB_SUPPORT
+#include <filesystem>
+#include <sstream>
+#include <cstring>
+#include <limits>
 
 namespace ecad {
 namespace model {
@@ -15,39 +25,31 @@ using namespace generic::fs;
 ECAD_API UPtr<EChipThermalModelV1> makeChipThermalModelFromCTMv1File(std::string_view filename, std::string * err)
 {
     using namespace detail;
+#ifdef ECAD_ZLIB_SUPPORT
+    std::string buffer;
+    std::unordered_map<std::string, std::string_view> members;
+    if (not ReadCTMv1Archive(filename, buffer, members, err)) return nullptr;
+    return makeChipThermalModelFromCTMv1Members(members, err);
+#else
+    //no in-process decompression, stage the archive to disk and remove it once parsed
     auto dir = UntarCTMv1File(filename, err);
     if(dir.empty()) {
         if(err) *err = Fmt2Str("Error: failed to unarchive the file %1%", filename);
         return nullptr;
     }
 
-    auto model = std::make_unique<EChipThermalModelV1>();
-
-    //header
-    auto headerFile = dir + GENERIC_FOLDER_SEPS + "CTM_header.txt";
-    if(!ParseCTMv1HeaderFile(headerFile, model->header, err)) return nullptr;
-    
-    //power
-    auto tiles = model->header.tiles;
-    model->powers = std::make_shared<EGridPowerModel>(tiles);
-    for(size_t i = 0; i < model->header.temperatures.size(); ++i) {
-        auto temperature = model->header.temperatures.at(i);
-        auto powerFile = dir + GENERIC_FOLDER_SEPS + Fmt2Str("power_T[%1%].ctm", i + 1);
-        EGridData powers(tiles.x, tiles.y);
-        if(!ParseCTMv1PowerFile(powerFile, powers, err)) return nullptr;
-        model->powers->GetTable().AddSample(temperature, std::move(powers));
+    std::vector<UPtr<EMappedFile> > files;
+    std::unordered_map<std::string, std::string_view> members;
+    for (const auto & entry : std::filesystem::directory_iterator(dir)) {
+        if (not entry.is_regular_file()) continue;
+        auto & file = files.emplace_back(new EMappedFile(entry.path().string()));
+        if (file->isOpen()) members.emplace(entry.path().filename().string(), file->View());
     }
-
-    //density
-    std::vector<SPtr<EGridData> > density;
-    for(size_t i = 0; i < model->header.layers.size(); ++i)
-        density.push_back(std::make_shared<EGridData>(tiles.x, tiles.y));
-    auto densityFile = dir + GENERIC_FOLDER_SEPS + "metal_density.ctm";
-    if(!ParseCTMv1DensityFile(densityFile, tiles.x * tiles.y, density, err)) return nullptr;
-    for(size_t i = 0; i < model->header.layers.size(); ++i)
-        model->densities.insert(std::make_pair(model->header.layers[i].name, density[i]));
-
+    auto model = makeChipThermalModelFromCTMv1Members(members, err);
+    files.clear();
+    RemoveDir(dir);
     return model;
+#endif//ECAD_ZLIB_SUPPORT
 }
 
 ECAD_INLINE bool GenerateCTMv1FileFromChipThermalModelV1(const EChipThermalModelV1 & model, std::string_view dirName, std::string_view filename, std::string * err)
@@ -155,6 +157,169 @@ ECAD_INLINE std::string UntarCTMv1File(std::string_view filename, std::string *
     return res == 0 ? untarDir : std::string{};
 }
 
+ECAD_INLINE bool ReadCTMv1Archive(std::string_view filename, std::string & buffer, std::unordered_map<std::string, std::string_view> & members, std::string * err)
+{
+    EMappedFile file;
+    if (not file.Open(filename)) {
+        if(err) *err = Fmt2Str("Error: file %1% not exists!", filename);
+        return false;
+    }
+
+    buffer.clear();
+    members.clear();
+    auto data = file.View();
+    bool gzip = data.size() > 2 && '\x1f' == data[0] && '\x8b' == data[1];
+    if (not gzip) buffer.assign(data);
+    else {
+#ifdef ECAD_ZLIB_SUPPORT
+        z_stream zs;
+        std::memset(&zs, 0, sizeof(zs));
+        if (Z_OK != inflateInit2(&zs, 15 + 16)) return false;
+        //zlib counts bytes in uInt, input and output are handed over in chunks so files of 4 GiB and more are not truncated
+        constexpr size_t maxChunk = std::numeric_limits<uInt>::max();
+        const char * next = data.data();
+        size_t remain = data.size();
+        buffer.resize(std::max<size_t>(data.size() * 4, 1 << 16));
+        size_t length = 0;
+        int res = Z_OK;
+        while (Z_OK == res) {
+            if (0 == zs.avail_in && remain > 0) {
+                zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(next));
+                zs.avail_in = static_cast<uInt>(std::min(remain, maxChunk));
+                next += zs.avail_in;
+                remain -= zs.avail_in;
+            }
+            if (length == buffer.size()) buffer.resize(buffer.size() * 2);
+            zs.next_out = reinterpret_cast<Bytef *>(buffer.data() + length);
+            zs.avail_out = static_cast<uInt>(std::min(buffer.size() - length, maxChunk));
+            res = inflate(&zs, Z_NO_FLUSH);
+            length = reinterpret_cast<char *>(zs.next_out) - buffer.data();
+            //concatenated gzip members
+            if (Z_STREAM_END == res && (zs.avail_in > 0 || remain > 0)) res = inflateReset(&zs);
+        }
+        inflateEnd(&zs);
+        buffer.resize(length);
+        if (Z_STREAM_END != res) {
+            if(err) *err = Fmt2Str("Error: failed to decompress the file %1%", filename);
+            return false;
+        }
+#else
+        if(err) *err = Fmt2Str("Error: zlib support is required to read the file %1%", filename);
+        return false;
+#endif//ECAD_ZLIB_SUPPORT
+    }
+
+    //ustar blocks, a header of 512 bytes followed by the member data padded to 512 bytes
+    const size_t block = 512;
+    auto field = [](std::string_view header, size_t offset, size_t size) {
+        auto str = header.substr(offset, size);
+        return str.substr(0, std::min(str.size(), str.find('\0')));
+    };
+    auto number = [](std::string_view str) {
+        size_t value = 0;
+        if (not str.empty() && (str[0] & 0x80)) {
+            //base-256 for large sizes
+            for (size_t i = 1; i < str.size(); ++i)
+                value = (value << 8) | static_cast<unsigned char>(str[i]);
+            return value;
+        }
+        for (auto c : str) {
+            if (c < '0' || c > '7') continue;
+            value = (value << 3) | (c - '0');
+        }
+        return value;
+    };
+
+    std::string_view archive(buffer), longName;
+    for (size_t pos = 0; pos + block <= archive.size();) {
+        auto header = archive.substr(pos, block);
+        if ('\0' == header[0]) break;//end of archive
+        auto size = number(header.substr(124, 12));
+        auto type = header[156];
+        pos += block;
+        if (pos + size > archive.size()) {
+            if(err) *err = Fmt2Str("Error: truncated archive %1%", filename);
+            return false;
+        }
+        auto content = archive.substr(pos, size);
+        pos += (size + block - 1) / block * block;
+
+        if ('L' == type) {//gnu long name of the next member
+            longName = content.substr(0, std::min(content.size(), content.find('\0')));
+            continue;
+        }
+        if ('0' != type && '\0' != type) { longName = {}; continue; }
+
+        std::string name(longName.empty() ? field(header, 0, 100) : longName);
+        if (longName.empty() && "ustar" == field(header, 257, 5)) {
+            if (auto prefix = field(header, 345, 155); not prefix.empty())
+                name = std::string(prefix) + "/" + name;
+        }
+        longName = {};
+        if (auto sep = name.find_last_of('/'); sep != std::string::npos) name = name.substr(sep + 1);
+        if (not name.empty()) members[name] = content;
+    }
+    return true;
+}
+
+ECAD_INLINE UPtr<EChipThermalModelV1> makeChipThermalModelFromCTMv1Members(const std::unordered_map<std::string, std::string_view> & members, std::string * err)
+{
+    auto member = [&](const std::string & name) -> CPtr<std::string_view> {
+        auto iter = members.find(name);
+        if (iter != members.cend()) return &iter->second;
+        if(err) *err = Fmt2Str("Error: missing %1% in ctm archive", name);
+        return nullptr;
+    };
+
+    auto model = std::make_unique<EChipThermalModelV1>();
+
+    //header
+    std::string headerName = "CTM_header.txt";
+    auto headerData = member(headerName);
+    if (nullptr == headerData) return nullptr;
+    std::istringstream headerStream{std::string(*headerData)};
+    if(!ParseCTMv1Header(headerStream, headerName, model->header, err)) return nullptr;
+
+    //power, one file per temperature parsed concurrently
+    auto tiles = model->header.tiles;
+    const auto & temperatures = model->header.temperatures;
+    std::vector<CPtr<std::string_view> > powerData(temperatures.size());
+    for(size_t i = 0; i < temperatures.size(); ++i) {
+        powerData[i] = member(Fmt2Str("power_T[%1%].ctm", i + 1));
+        if (nullptr == powerData[i]) return nullptr;
+    }
+    std::vector<EGridData> powers(temperatures.size(), EGridData(tiles.x, tiles.y));
+    std::vector<char> parsed(temperatures.size(), false);
+    {
+        generic::thread::ThreadPool pool(std::max<size_t>(1, std::min(temperatures.size(), EDataMgr::Instance().Threads())));
+        for(size_t i = 0; i < temperatures.size(); ++i)
+            pool.Submit([&, i] { parsed[i] = ParseCTMv1PowerData(powerData[i]->data(), powerData[i]->size(), powers[i]); });
+    }
+    for(size_t i = 0; i < temperatures.size(); ++i) {
+        if (parsed[i]) continue;
+        if(err) *err = Fmt2Str("Error: power_T[%1%].ctm in ctm archive holds less than %2% tiles", i + 1, tiles.x * tiles.y);
+        return nullptr;
+    }
+    model->powers = std::make_shared<EGridPowerModel>(tiles);
+    for(size_t i = 0; i < temperatures.size(); ++i)
+        model->powers->GetTable().AddSample(temperatures.at(i), std::move(powers[i]));
+
+    //density
+    std::vector<SPtr<EGridData> > density;
+    for(size_t i = 0; i < model->header.layers.size(); ++i)
+        density.push_back(std::make_shared<EGridData>(tiles.x, tiles.y));
+    auto densityData = member("metal_density.ctm");
+    if (nullptr == densityData) return nullptr;
+    if (not ParseCTMv1DensityData(densityData->data(), densityData->size(), tiles.x * tiles.y, density)) {
+        if(err) *err = Fmt2Str("Error: metal_density.ctm in ctm archive holds less than %1% tiles of %2% layers", tiles.x * tiles.y, density.size());
+        return nullptr;
+    }
+    for(size_t i = 0; i < model->header.layers.size(); ++i)
+        model->densities.insert(std::make_pair(model->header.layers[i].name, density[i]));
+
+    return model;
+}
+
 ECAD_INLINE bool ParseCTMv1HeaderFile(std::string_view filename, ECTMv1Header & header, std::string * err)
 {
     std::ifstream fp(filename.data(), std::ios::in);
@@ -162,7 +327,11 @@ ECAD_INLINE bool ParseCTMv1HeaderFile(std::string_view filename, ECTMv1Header &
         if(err) *err = Fmt2Str("Error: failed to open file %1%!", filename);
         return false;
     }
+    return ParseCTMv1Header(fp, filename, header, err);
+}
 
+ECAD_INLINE bool ParseCTMv1Header(std::istream & fp, std::string_view filename, ECTMv1Header & header, std::string * err)
+{
     auto decrypt = [err](const std::string & s, size_t len) {
         auto tmp = s;
         std::for_each(tmp.begin(), tmp.end(), [&](char & c){ c -= 3 * len + 22; });
@@ -326,57 +495,66 @@ ECAD_INLINE bool ParseCTMv1HeaderFile(std::string_view filename, ECTMv1Header &
             }
         }  
     }
-
-    fp.close();
     return true;
 }
 
 ECAD_INLINE bool ParseCTMv1PowerFile(std::string_view filename, EGridData & powers, std::string * err)
 {
-    std::ifstream fp(filename.data(), std::ios::in | std::ios::binary);
-    if (not fp.good()) {
+    EMappedFile file;
+    if (not file.Open(filename)) {
         if (err) *err = Fmt2Str("Error: failed to open file %1%!", filename);
         return false;
     }
-
-    float f;
-    size_t i = 0, size = powers.Size();
-    while(fp.read(reinterpret_cast<char*>(&f), sizeof(float)) && i < size) { powers[i++] = f; }
-    
-    fp.close();
+    ParseCTMv1PowerData(file.Data(), file.Size(), powers);
     return true;
 }
 
-ECAD_API bool ParseCTMv1DensityFile(std::string_view filename, const size_t size, std::vector<SPtr<EGridData> > & density, std::string * err)
+ECAD_INLINE bool ParseCTMv1DensityFile(std::string_view filename, const size_t size, std::vector<SPtr<EGridData> > & density, std::string * err)
 {
-    std::ifstream fp(filename.data(), std::ios::in | std::ios::binary);
-    if (not fp.good()) {
+    EMappedFile file;
+    if (not file.Open(filename)) {
         if(err) *err = Fmt2Str("Error: failed to open file %1%!", filename);
         return false;
     }
+    ParseCTMv1DensityData(file.Data(), file.Size(), size, density);
+    return true;
+}
 
-    int id;
-    float f;
-    size_t i = 0;
-    while(!fp.eof() && i < size) {
-        //id
-        fp.read(reinterpret_cast<char*>(&id), sizeof(int));
-
-        //4 float number for tile box
-        for(size_t j = 0; j < 4; ++j)
-            fp.read(reinterpret_cast<char*>(&f), sizeof(float));
-        
-        //density of all layers in LAYER section
-        for(size_t j = 0; j < density.size(); ++j) {
-            fp.read(reinterpret_cast<char*>(&f), sizeof(float));
-            (*density[j])[i] = f;
-        }
-
-        i++;
+ECAD_INLINE bool ParseCTMv1PowerData(CPtr<char> data, size_t bytes, EGridData & powers)
+{
+    //memcpy per value, the data may be unaligned when it comes from an archive buffer
+    auto size = std::min(powers.Size(), bytes / sizeof(float));
+    for (size_t i = 0; i < size; ++i) {
+        float f;
+        std::memcpy(&f, data + i * sizeof(float), sizeof(float));
+        powers[i] = f;
     }
+    return size == powers.Size();
+}
 
-    fp.close();
-    return true;
+ECAD_INLINE bool ParseCTMv1DensityData(CPtr<char> data, size_t bytes, const size_t size, std::vector<SPtr<EGridData> > & density)
+{
+    //skip id and the 4 floats of the tile box
+    const size_t head = sizeof(int) + 4 * sizeof(float);
+    const size_t record = head + density.size() * sizeof(float);
+    const size_t records = std::min(size, bytes / record);
+
+    //transpose the records into one grid per layer a block of tiles at a time,
+    //each layer pass reads the block from cache and writes its grid sequentially
+    const size_t blockSize = 4096;
+    for (size_t begin = 0; begin < records; begin += blockSize) {
+        auto end = std::min(records, begin + blockSize);
+        for (size_t j = 0; j < density.size(); ++j) {
+            auto & layer = *density[j];
+            auto src = data + head + j * sizeof(float);
+            for (size_t i = begin; i < end; ++i) {
+                float f;
+                std::memcpy(&f, src + i * record, sizeof(float));
+                layer[i] = f;
+            }
+        }
+    }
+    return records == size;
 }
 
 ECAD_INLINE bool WriteCTMv1HeaderFile(std::string_view filename, const ECTMv1Header & header, std::string * err)
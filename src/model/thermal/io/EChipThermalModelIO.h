@@ -1,5 +1,6 @@
 #pragma once
 #include "model/thermal/io/EGridThermalModelIO.h"
+#include <unordered_map>
 #include <set>
 
 namespace ecad {
@@ -14,9 +15,21 @@ ECAD_API bool GenerateCTMv1ImageProfiles(const EChipThermalModelV1 & model, std:
 namespace detail {
 
 ECAD_API std::string UntarCTMv1File(std::string_view filename, std::string * err = nullptr);//return untar folder if success else empty string
+///@brief reads a ctm tar or tar.gz archive into buffer, members maps the base name of each regular file to its bytes in buffer,
+///       gzip archives require zlib support
+ECAD_API bool ReadCTMv1Archive(std::string_view filename, std::string & buffer, std::unordered_map<std::string, std::string_view> & members, std::string * err = nullptr);
+///@brief builds the model from the ctm files held in memory, keyed by base name, power files are parsed concurrently
+ECAD_API UPtr<EChipThermalModelV1> makeChipThermalModelFromCTMv1Members(const std::unordered_map<std::string, std::string_view> & members, std::string * err = nullptr);
 ECAD_API bool ParseCTMv1HeaderFile(std::string_view filename, ECTMv1Header & header, std::string * err = nullptr);
+ECAD_API bool ParseCTMv1Header(std::istream & fp, std::string_view filename, ECTMv1Header & header, std::string * err = nullptr);
 ECAD_API bool ParseCTMv1PowerFile(std::string_view filename, EGridData & powers, std::string * err = nullptr);
 ECAD_API bool ParseCTMv1DensityFile(std::string_view filename, const size_t size, std::vector<SPtr<EGridData> > & density, std::string * err = nullptr);
+///@brief parse the binary content of a power file held in memory, fills as many tiles as the data holds,
+///       returns false if the data is shorter than the grid
+ECAD_API bool ParseCTMv1PowerData(CPtr<char> data, size_t bytes, EGridData & powers);
+///@brief parse the binary content of a metal density file held in memory, records are
+///       [int id, float box[4], float density[layers]], only complete records are read, returns false if there are less than size
+ECAD_API bool ParseCTMv1DensityData(CPtr<char> data, size_t bytes, const size_t size, std::vector<SPtr<EGridData> > & density);
 
 ECAD_API bool WriteCTMv1HeaderFile(std::string_view filename, const ECTMv1Header & header, std::string * err = nullptr);
 ECAD_API bool WriteCTMv1PowerFile(std::string_view filename, const EGridData & powers, std::string * err = nullptr);
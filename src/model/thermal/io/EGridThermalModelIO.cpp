@@ -1,4 +1,5 @@
 #include "model/thermal/io/EGridThermalModelIO.h"
+#include "model/thermal/io/EVTUWriter.h"
 
 #include "generic/tools/StringHelper.hpp"
 #include "generic/tools/FileSystem.hpp"
@@ -13,6 +14,10 @@ using namespace generic::str;
 using namespace generic::fmt;
 using namespace generic::fs;
 
+namespace detail {
+ECAD_INLINE UPtr<EVTUWriter> makeVTUWriter(const EGridThermalModel & model, bool compress);
+}//namespace detail
+
 ECAD_INLINE bool GenerateTxtProfile(const EGridThermalModel & model, std::string_view filename, std::string * err)
 {
     CreateDir(DirName(filename));    
@@ -73,8 +78,84 @@ ECAD_INLINE bool GenerateTxtProfile(const EGridThermalModel & model, std::string
     return true;
 }
 
+template <typename Scalar>
+ECAD_INLINE bool GenerateVTUFile(std::string_view filename, const EGridThermalModel & model, const std::vector<Scalar> * temperature, bool compress, std::string * err)
+{
+    auto writer = detail::makeVTUWriter(model, compress);
+    if (temperature && temperature->size() == model.TotalGrids())
+        writer->AddCellData("temperature", EVTUWriter::makeFiller(*temperature));
+    return writer->Write(filename, err);
+}
+
+template <typename Scalar>
+ECAD_INLINE bool GenerateVTUFile(std::string_view filename, const EGridThermalModel & model, const std::vector<Scalar> & times, const std::vector<std::vector<Scalar> > & temperatures, bool compress, std::string * err)
+{
+    if (times.size() != temperatures.size()) {
+        if (err) *err = "Error: mismatched sample times and temperatures";
+        return false;
+    }
+    auto writer = detail::makeVTUWriter(model, compress);
+    for (size_t i = 0; i < temperatures.size(); ++i) {
+        if (temperatures.at(i).size() != model.TotalGrids()) {
+            if (err) *err = "Error: mismatched temperature size of sample " + std::to_string(i);
+            return false;
+        }
+        writer->AddCellData("temperature_" + std::to_string(i), EVTUWriter::makeFiller(temperatures.at(i)));
+    }
+    writer->AddFieldData("TimeValue", std::vector<Float64>(times.begin(), times.end()));
+    return writer->Write(filename, err);
+}
+
+template ECAD_INLINE bool GenerateVTUFile<Float32>(std::string_view filename, const EGridThermalModel & model, const std::vector<Float32> * temperature, bool compress, std::string * err);
+template ECAD_INLINE bool GenerateVTUFile<Float64>(std::string_view filename, const EGridThermalModel & model, const std::vector<Float64> * temperature, bool compress, std::string * err);
+template ECAD_INLINE bool GenerateVTUFile<Float32>(std::string_view filename, const EGridThermalModel & model, const std::vector<Float32> & times, const std::vector<std::vector<Float32> > & temperatures, bool compress, std::string * err);
+template ECAD_INLINE bool GenerateVTUFile<Float64>(std::string_view filename, const EGridThermalModel & model, const std::vector<Float64> & times, const std::vector<std::vector<Float64> > & temperatures, bool compress, std::string * err);
+
 namespace detail {
 
+ECAD_INLINE UPtr<EVTUWriter> makeVTUWriter(const EGridThermalModel & model, bool compress)
+{
+    //points on the (nx + 1) x (ny + 1) x (nz + 1) lattice, cells in the flatten index order of the model
+    const auto size = model.ModelSize();
+    const size_t px = size.x + 1, py = size.y + 1, pz = size.z + 1;
+    const auto ll = model.GetRegion(false)[0];
+    const auto res = model.GetResolution(false);
+    std::vector<Float64> elevations(pz, 0);
+    for (size_t z = 0; z < size.z; ++z)
+        elevations[z + 1] = elevations[z] - model.GetLayers().at(z).GetThickness();
+
+    auto writer = std::make_unique<EVTUWriter>(px * py * pz, model.TotalGrids(), compress);
+    writer->SetPoints([=](size_t begin, size_t end, Ptr<Float64> buffer) {
+        for (size_t i = begin; i < end; ++i) {
+            auto p = i / 3;
+            switch (i % 3) {
+                case 0 : *buffer++ = ll[0] + res[0] * (p % px); break;
+                case 1 : *buffer++ = ll[1] + res[1] * (p / px % py); break;
+                default : *buffer++ = elevations[p / px / py]; break;
+            }
+        }
+    });
+    auto connects = [&model, px, py](size_t begin, size_t end, Ptr<Int64> buffer) {
+        //bottom face first, both faces counter-clockwise seen from the top
+        constexpr std::array<size_t, 8> dx{0, 1, 1, 0, 0, 1, 1, 0};
+        constexpr std::array<size_t, 8> dy{0, 0, 1, 1, 0, 0, 1, 1};
+        constexpr std::array<size_t, 8> dz{1, 1, 1, 1, 0, 0, 0, 0};
+        for (size_t i = begin; i < end; ++i) {
+            auto index = model.GetGridIndex(i / 8);
+            auto n = i % 8;
+            *buffer++ = ((index.z + dz[n]) * py + index.y + dy[n]) * px + index.x + dx[n];
+        }
+    };
+    auto offsets = [](size_t begin, size_t end, Ptr<Int64> buffer) {
+        for (size_t i = begin; i < end; ++i) *buffer++ = 8 * (i + 1);
+    };
+    auto types = [](size_t begin, size_t end, Ptr<uint8_t> buffer) {
+        std::fill(buffer, buffer + (end - begin), EVTUWriter::Hexahedron);
+    };
+    writer->SetCells(model.TotalGrids() * 8, connects, offsets, types);
+    return writer;
+}
+
 ECAD_INLINE bool GenerateImageProfile(std::string_view filename, const EGridData & data, double min, double max)
 {
     if(min > max)
@@ -7,6 +7,14 @@ ECAD_API bool GenerateTxtProfile(const EGridThermalModel & model, std::string_vi
 
 ECAD_API bool GenerateImageProfiles(const EGridThermalModel & model, std::string_view dirName, std::string * err = nullptr);
 
+///@brief binary vtk xml unstructured grid of hexahedra, layer 0 on top, optionally zlib compressed
+template <typename Scalar>
+ECAD_API bool GenerateVTUFile(std::string_view filename, const EGridThermalModel & model, const std::vector<Scalar> * temperature = nullptr, bool compress = false, std::string * err = nullptr);
+
+///@brief writes all samples of a transient result into one vtu file, one cell array per sample and the sample times as field data
+template <typename Scalar>
+ECAD_API bool GenerateVTUFile(std::string_view filename, const EGridThermalModel & model, const std::vector<Scalar> & times, const std::vector<std::vector<Scalar> > & temperatures, bool compress = false, std::string * err = nullptr);
+
 namespace detail {
 ECAD_API bool GenerateImageProfile(std::string_view filename, const EGridData & data, double min, double max);
 }
@@ -1,7 +1,43 @@
 #include "EPrismThermalModelIO.h"
+#include "EVTUWriter.h"
 #include "generic/tools/Color.hpp"
 namespace ecad::model::io {
 
+namespace detail {
+
+ECAD_INLINE UPtr<EVTUWriter> makeVTUWriter(const EPrismThermalModel & model, bool compress)
+{
+    const auto & points = model.GetPoints();
+    const size_t prisms = model.TotalPrismElements();
+    auto writer = std::make_unique<EVTUWriter>(points.size(), model.TotalElements(), compress);
+    writer->SetPoints([&points](size_t begin, size_t end, Ptr<Float64> buffer) {
+        for (size_t i = begin; i < end; ++i)
+            *buffer++ = points[i / 3][i % 3];
+    });
+    //prisms go first with 6 vertices each, followed by lines with 2 end points each
+    auto connects = [&model, prisms](size_t begin, size_t end, Ptr<Int64> buffer) {
+        for (size_t i = begin; i < end; ++i) {
+            if (i < prisms * 6) *buffer++ = model.GetPrism(i / 6).vertices[i % 6];
+            else {
+                const auto & endPts = model.GetLine((i - prisms * 6) / 2).endPoints;
+                *buffer++ = (i - prisms * 6) % 2 ? endPts.back() : endPts.front();
+            }
+        }
+    };
+    auto offsets = [prisms](size_t begin, size_t end, Ptr<Int64> buffer) {
+        for (size_t i = begin; i < end; ++i)
+            *buffer++ = i < prisms ? 6 * (i + 1) : 6 * prisms + 2 * (i + 1 - prisms);
+    };
+    auto types = [prisms](size_t begin, size_t end, Ptr<uint8_t> buffer) {
+        for (size_t i = begin; i < end; ++i)
+            *buffer++ = i < prisms ? EVTUWriter::Wedge : EVTUWriter::Line;
+    };
+    writer->SetCells(prisms * 6 + model.TotalLineElements() * 2, connects, offsets, types);
+    return writer;
+}
+
+} // namespace detail
+
 template <typename Scalar>
 ECAD_INLINE bool GenerateVTKFile(std::string_view filename, const EPrismThermalModel & model, const std::vector<Scalar> * temperature, std::string * err)
 {
@@ -67,7 +103,40 @@ ECAD_INLINE bool GenerateVTKFile(std::string_view filename, const EPrismThermalM
     return true;
 }
 
+template <typename Scalar>
+ECAD_INLINE bool GenerateVTUFile(std::string_view filename, const EPrismThermalModel & model, const std::vector<Scalar> * temperature, bool compress, std::string * err)
+{
+    auto writer = detail::makeVTUWriter(model, compress);
+    if (temperature && temperature->size() == model.TotalElements())
+        writer->AddCellData("temperature", EVTUWriter::makeFiller(*temperature));
+    return writer->Write(filename, err);
+}
+
+template <typename Scalar>
+ECAD_INLINE bool GenerateVTUFile(std::string_view filename, const EPrismThermalModel & model, const std::vector<Scalar> & times, const std::vector<std::vector<Scalar> > & temperatures, bool compress, std::string * err)
+{
+    if (times.size() != temperatures.size()) {
+        if (err) *err = "Error: mismatched sample times and temperatures";
+        return false;
+    }
+    auto writer = detail::makeVTUWriter(model, compress);
+    for (size_t i = 0; i < temperatures.size(); ++i) {
+        if (temperatures.at(i).size() != model.TotalElements()) {
+            if (err) *err = "Error: mismatched temperature size of sample " + std::to_string(i);
+            return false;
+        }
+        writer->AddCellData("temperature_" + std::to_string(i), EVTUWriter::makeFiller(temperatures.at(i)));
+    }
+    writer->AddFieldData("TimeValue", std::vector<Float64>(times.begin(), times.end()));
+    return writer->Write(filename, err);
+}
+
 template ECAD_INLINE bool GenerateVTKFile<Float32>(std::string_view filename, const EPrismThermalModel & model, const std::vector<Float32> * temperature, std::string * err);
 template ECAD_INLINE bool GenerateVTKFile<Float64>(std::string_view filename, const EPrismThermalModel & model, const std::vector<Float64> * temperature, std::string * err);
 
+template ECAD_INLINE bool GenerateVTUFile<Float32>(std::string_view filename, const EPrismThermalModel & model, const std::vector<Float32> * temperature, bool compress, std::string * err);
+template ECAD_INLINE bool GenerateVTUFile<Float64>(std::string_view filename, const EPrismThermalModel & model, const std::vector<Float64> * temperature, bool compress, std::string * err);
+template ECAD_INLINE bool GenerateVTUFile<Float32>(std::string_view filename, const EPrismThermalModel & model, const std::vector<Float32> & times, const std::vector<std::vector<Float32> > & temperatures, bool compress, std::string * err);
+template ECAD_INLINE bool GenerateVTUFile<Float64>(std::string_view filename, const EPrismThermalModel & model, const std::vector<Float64> & times, const std::vector<std::vector<Float64> > & temperatures, bool compress, std::string * err);
+
 } // namespace ecad::model::io
\ No newline at end of file
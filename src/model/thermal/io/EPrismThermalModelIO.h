@@ -6,4 +6,12 @@ namespace ecad::model::io {
 template <typename Scalar>
 ECAD_API bool GenerateVTKFile(std::string_view filename, const EPrismThermalModel & model, const std::vector<Scalar> * temperature = nullptr, std::string * err = nullptr);
 
+///@brief binary vtk xml unstructured grid, optionally zlib compressed
+template <typename Scalar>
+ECAD_API bool GenerateVTUFile(std::string_view filename, const EPrismThermalModel & model, const std::vector<Scalar> * temperature = nullptr, bool compress = false, std::string * err = nullptr);
+
+///@brief writes all samples of a transient result into one vtu file, one cell array per sample and the sample times as field data
+template <typename Scalar>
+ECAD_API bool GenerateVTUFile(std::string_view filename, const EPrismThermalModel & model, const std::vector<Scalar> & times, const std::vector<std::vector<Scalar> > & temperatures, bool compress = false, std::string * err = nullptr);
+
 } // namespace ecad::model::io
\ No newline at end of file
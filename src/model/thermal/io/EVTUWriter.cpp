@@ -0,0 +1,196 @@
+#include "EVTUWriter.h"
+#include "generic/tools/FileSystem.hpp"
+#ifdef ECAD_ZLIB_SUPPORT
+#include <zlib.h>
+#endif//ECAD_ZLIB_SUPPORT
+#include <fstream>
+#include <iomanip>
+namespace ecad::model::io {
+
+ECAD_INLINE EVTUWriter::EVTUWriter(size_t points, size_t cells, bool compress)
+ : m_points(points), m_cells(cells), m_compress(compress && CompressionSupported())
+{
+}
+
+ECAD_INLINE void EVTUWriter::SetPoints(Filler<Float64> coords)
+{
+    m_pointData.clear();
+    m_pointData.emplace_back(makeArray<Float64>("Points", 3, m_points * 3, std::move(coords)));
+}
+
+ECAD_INLINE void EVTUWriter::SetCells(size_t connectivity, Filler<Int64> connects, Filler<Int64> offsets, Filler<uint8_t> types)
+{
+    m_cellArrays.clear();
+    m_cellArrays.emplace_back(makeArray<Int64>("connectivity", 1, connectivity, std::move(connects)));
+    m_cellArrays.emplace_back(makeArray<Int64>("offsets", 1, m_cells, std::move(offsets)));
+    m_cellArrays.emplace_back(makeArray<uint8_t>("types", 1, m_cells, std::move(types)));
+}
+
+ECAD_INLINE void EVTUWriter::AddFieldData(std::string name, std::vector<Float64> values)
+{
+    auto data = std::make_shared<std::vector<Float64> >(std::move(values));
+    m_fieldData.emplace_back(makeArray<Float64>(std::move(name), 1, data->size(), [data](size_t begin, size_t end, Ptr<Float64> buffer) {
+        std::copy(data->begin() + begin, data->begin() + end, buffer);
+    }));
+}
+
+ECAD_INLINE bool EVTUWriter::CompressionSupported()
+{
+#ifdef ECAD_ZLIB_SUPPORT
+    return true;
+#else
+    return false;
+#endif//ECAD_ZLIB_SUPPORT
+}
+
+namespace detail {
+
+///@brief raw encoding: UInt64 byte count followed by the values
+ECAD_INLINE void WriteRawArray(std::ostream & out, size_t bytes, size_t typeSize, const std::function<void(size_t, size_t, Ptr<void>)> & filler, std::vector<char> & buffer)
+{
+    uint64_t header = bytes;
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    const size_t size = bytes / typeSize;
+    const size_t block = EVTUWriter::blockBytes / typeSize;
+    for (size_t begin = 0; begin < size; begin += block) {
+        auto end = std::min(begin + block, size);
+        filler(begin, end, buffer.data());
+        out.write(buffer.data(), (end - begin) * typeSize);
+    }
+}
+
+#ifdef ECAD_ZLIB_SUPPORT
+///@brief vtkZLibDataCompressor encoding: [blocks, block size, last block size, compressed sizes...] followed by the compressed blocks,
+///       the header is reserved and patched once the blocks are written, so only one block is held in memory
+ECAD_INLINE size_t WriteCompressedArray(std::ostream & out, size_t bytes, size_t typeSize, const std::function<void(size_t, size_t, Ptr<void>)> & filler, std::vector<char> & buffer)
+{
+    const size_t size = bytes / typeSize;
+    const size_t block = EVTUWriter::blockBytes / typeSize;
+    const size_t blocks = (size + block - 1) / block;
+    std::vector<uint64_t> header{blocks, EVTUWriter::blockBytes, bytes % EVTUWriter::blockBytes};
+    header.resize(3 + blocks, 0);
+    auto headerPos = out.tellp();
+    out.write(reinterpret_cast<const char *>(header.data()), header.size() * sizeof(uint64_t));
+
+    size_t total = header.size() * sizeof(uint64_t);
+    std::vector<char> compressed(compressBound(EVTUWriter::blockBytes));
+    for (size_t begin = 0, b = 0; begin < size; begin += block, ++b) {
+        auto end = std::min(begin + block, size);
+        filler(begin, end, buffer.data());
+        uLongf length = compressed.size();
+        [[maybe_unused]] auto res = compress2(reinterpret_cast<Bytef *>(compressed.data()), &length,
+                                              reinterpret_cast<const Bytef *>(buffer.data()), (end - begin) * typeSize, Z_DEFAULT_COMPRESSION);
+        ECAD_ASSERT(Z_OK == res)
+        header[3 + b] = length;
+        out.write(compressed.data(), length);
+        total += length;
+    }
+
+    auto endPos = out.tellp();
+    out.seekp(headerPos);
+    out.write(reinterpret_cast<const char *>(header.data()), header.size() * sizeof(uint64_t));
+    out.seekp(endPos);
+    return total;
+}
+#endif//ECAD_ZLIB_SUPPORT
+
+} // namespace detail
+
+ECAD_INLINE bool EVTUWriter::Write(std::string_view filename, std::string * err) const
+{
+    if (m_pointData.empty() || m_cellArrays.empty()) {
+        if (err) *err = "Error: vtu points or cells are not set";
+        return false;
+    }
+
+    //a string_view is not necessarily null terminated
+    const std::string path(filename);
+    if (not fs::CreateDir(fs::DirName(path))) {
+        if (err) *err = "Error: fail to create folder " + fs::DirName(path).string();
+        return false;
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (not out.is_open()) {
+        if (err) *err = "Error: fail to open: " + path;
+        return false;
+    }
+
+    std::vector<CPtr<Array> > arrays;
+    for (const auto * group : {&m_fieldData, &m_pointData, &m_cellArrays, &m_cellData})
+        for (const auto & array : *group) arrays.emplace_back(&array);
+
+    //raw offsets are known up front, compressed ones are written as fixed width placeholders and patched after the data
+    std::vector<char> buffer(blockBytes);
+    std::vector<size_t> offsets(arrays.size() + 1, 0);
+    std::vector<std::ostream::pos_type> offsetPos(arrays.size());
+    for (size_t i = 0; i < arrays.size() && not m_compress; ++i) {
+        const auto & array = *arrays.at(i);
+        offsets[i + 1] = offsets[i] + sizeof(uint64_t) + array.size * array.typeSize;
+    }
+
+    size_t index = 0;
+    auto writeDataArray = [&](const std::string & indent) {
+        const auto & array = *arrays.at(index);
+        out << indent << "<DataArray type=\"" << array.type << "\" Name=\"" << array.name << "\"";
+        if (array.components > 1) out << " NumberOfComponents=\"" << array.components << "\"";
+        if (index < m_fieldData.size())//field data goes first
+            out << " NumberOfTuples=\"" << array.size << "\"";
+        out << " format=\"appended\" offset=\"";
+        offsetPos[index] = out.tellp();
+        if (m_compress) out << std::setw(offsetDigits) << std::setfill('0') << 0;
+        else out << offsets.at(index);
+        out << "\"/>" << ECAD_EOL;
+        index++;
+    };
+
+    const uint16_t endian = 1;
+    bool littleEndian = *reinterpret_cast<const uint8_t *>(&endian) == 1;
+    out << "<?xml version=\"1.0\"?>" << ECAD_EOL;
+    out << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"" << (littleEndian ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\"";
+    if (m_compress) out << " compressor=\"vtkZLibDataCompressor\"";
+    out << ">" << ECAD_EOL;
+    out << "  <UnstructuredGrid>" << ECAD_EOL;
+    if (not m_fieldData.empty()) {
+        out << "    <FieldData>" << ECAD_EOL;
+        for (size_t i = 0; i < m_fieldData.size(); ++i) writeDataArray("      ");
+        out << "    </FieldData>" << ECAD_EOL;
+    }
+    out << "    <Piece NumberOfPoints=\"" << m_points << "\" NumberOfCells=\"" << m_cells << "\">" << ECAD_EOL;
+    out << "      <Points>" << ECAD_EOL;
+    writeDataArray("        ");
+    out << "      </Points>" << ECAD_EOL;
+    out << "      <Cells>" << ECAD_EOL;
+    for (size_t i = 0; i < m_cellArrays.size(); ++i) writeDataArray("        ");
+    out << "      </Cells>" << ECAD_EOL;
+    if (not m_cellData.empty()) {
+        out << "      <CellData Scalars=\"" << m_cellData.front().name << "\">" << ECAD_EOL;
+        for (size_t i = 0; i < m_cellData.size(); ++i) writeDataArray("        ");
+        out << "      </CellData>" << ECAD_EOL;
+    }
+    out << "    </Piece>" << ECAD_EOL;
+    out << "  </UnstructuredGrid>" << ECAD_EOL;
+    out << "  <AppendedData encoding=\"raw\">" << ECAD_EOL << "   _";
+    for (size_t i = 0; i < arrays.size(); ++i) {
+        const auto & array = *arrays.at(i);
+#ifdef ECAD_ZLIB_SUPPORT
+        if (m_compress) {
+            offsets[i + 1] = offsets[i] + detail::WriteCompressedArray(out, array.size * array.typeSize, array.typeSize, array.filler, buffer);
+            continue;
+        }
+#endif//ECAD_ZLIB_SUPPORT
+        detail::WriteRawArray(out, array.size * array.typeSize, array.typeSize, array.filler, buffer);
+    }
+    out << ECAD_EOL << "  </AppendedData>" << ECAD_EOL;
+    out << "</VTKFile>" << ECAD_EOL;
+
+    if (m_compress) {
+        for (size_t i = 0; i < arrays.size(); ++i) {
+            out.seekp(offsetPos.at(i));
+            out << std::setw(offsetDigits) << std::setfill('0') << offsets.at(i);
+        }
+    }
+    return out.good();
+}
+
+} // namespace ecad::model::io
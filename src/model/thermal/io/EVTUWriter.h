@@ -0,0 +1,116 @@
+#pragma once
+#include "basic/ECadCommon.h"
+#include <functional>
+#include <memory>
+#include <type_traits>
+namespace ecad::model::io {
+
+///@brief VTK XML unstructured grid (.vtu) writer, all arrays are streamed in fixed-size blocks into one appended binary section
+class ECAD_API EVTUWriter
+{
+public:
+    ///@brief fills the values [begin, end) of an array into buffer
+    template <typename T>
+    using Filler = std::function<void(size_t begin, size_t end, Ptr<T> buffer)>;
+    enum CellType : uint8_t { Line = 3, Hexahedron = 12, Wedge = 13 };
+
+    ///@brief compression is ignored if zlib is not available, see CompressionSupported()
+    explicit EVTUWriter(size_t points, size_t cells, bool compress = false);
+    virtual ~EVTUWriter() = default;
+
+    ///@brief 3 values per point
+    void SetPoints(Filler<Float64> coords);
+    ///@brief connectivity is the total number of point indices of all cells
+    void SetCells(size_t connectivity, Filler<Int64> connects, Filler<Int64> offsets, Filler<uint8_t> types);
+
+    template <typename Scalar>
+    void AddCellData(std::string name, Filler<Scalar> values);
+    template <typename Scalar>
+    void AddCellData(std::string name, std::vector<Scalar> values);
+    void AddFieldData(std::string name, std::vector<Float64> values);
+
+    bool Write(std::string_view filename, std::string * err = nullptr) const;
+
+    ///@brief filler reading from values without a copy, values must outlive Write()
+    template <typename T>
+    static Filler<T> makeFiller(const std::vector<T> & values);
+
+    static bool CompressionSupported();
+    static constexpr size_t blockBytes = 1 << 20;
+
+private:
+    struct Array
+    {
+        std::string name;
+        std::string_view type;
+        size_t typeSize{0};
+        size_t components{1};
+        size_t size{0};
+        std::function<void(size_t, size_t, Ptr<void>)> filler;
+    };
+
+    template <typename T>
+    static Array makeArray(std::string name, size_t components, size_t size, Filler<T> filler);
+    template <typename T>
+    static constexpr std::string_view TypeName();
+
+    static constexpr size_t offsetDigits = 20;//fixed width of the compressed offsets patched after the appended data
+
+private:
+    size_t m_points{0};
+    size_t m_cells{0};
+    bool m_compress{false};
+    std::vector<Array> m_fieldData;
+    std::vector<Array> m_pointData;//points, single entry
+    std::vector<Array> m_cellArrays;//connectivity, offsets, types
+    std::vector<Array> m_cellData;
+};
+
+template <typename T>
+ECAD_ALWAYS_INLINE constexpr std::string_view EVTUWriter::TypeName()
+{
+    if constexpr (std::is_same_v<T, Float32>) return "Float32";
+    else if constexpr (std::is_same_v<T, Float64>) return "Float64";
+    else if constexpr (std::is_same_v<T, Int64>) return "Int64";
+    else {
+        static_assert(std::is_same_v<T, uint8_t>, "unsupported vtu data type");
+        return "UInt8";
+    }
+}
+
+template <typename T>
+ECAD_ALWAYS_INLINE EVTUWriter::Array EVTUWriter::makeArray(std::string name, size_t components, size_t size, Filler<T> filler)
+{
+    Array array;
+    array.name = std::move(name);
+    array.type = TypeName<T>();
+    array.typeSize = sizeof(T);
+    array.components = components;
+    array.size = size;
+    array.filler = [filler = std::move(filler)](size_t begin, size_t end, Ptr<void> buffer) { filler(begin, end, static_cast<Ptr<T>>(buffer)); };
+    return array;
+}
+
+template <typename Scalar>
+ECAD_ALWAYS_INLINE void EVTUWriter::AddCellData(std::string name, Filler<Scalar> values)
+{
+    m_cellData.emplace_back(makeArray<Scalar>(std::move(name), 1, m_cells, std::move(values)));
+}
+
+template <typename Scalar>
+ECAD_ALWAYS_INLINE void EVTUWriter::AddCellData(std::string name, std::vector<Scalar> values)
+{
+    ECAD_ASSERT(values.size() == m_cells)
+    auto data = std::make_shared<std::vector<Scalar> >(std::move(values));
+    AddCellData<Scalar>(std::move(name), [data](size_t begin, size_t end, Ptr<Scalar> buffer) {
+        std::copy(data->begin() + begin, data->begin() + end, buffer);
+    });
+}
+
+template <typename T>
+ECAD_ALWAYS_INLINE EVTUWriter::Filler<T> EVTUWriter::makeFiller(const std::vector<T> & values)
+{
+    return [&values](size_t begin, size_t end, Ptr<T> buffer) { std::copy(values.begin() + begin, values.begin() + end, buffer); };
+}
+
+} // namespace ecad::model::io
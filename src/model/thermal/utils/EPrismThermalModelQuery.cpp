@@ -5,7 +5,7 @@ namespace ecad {
 namespace model {
 namespace utils {
 ECAD_INLINE EPrismThermalModelQuery::EPrismThermalModelQuery(CPtr<EPrismThermalModel> model, bool lazyBuild)
- : m_model(model)
+ : m_model(model), m_lyrRtrees(model->TotalLayers())
 {
     if (not lazyBuild) {
         generic::thread::ThreadPool pool(EDataMgr::Instance().Threads());
@@ -51,37 +51,39 @@ ECAD_INLINE size_t EPrismThermalModelQuery::NearestLayer(EFloat height) const
 
 ECAD_INLINE CPtr<EPrismThermalModelQuery::Rtree> EPrismThermalModelQuery::BuildIndexTree() const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (nullptr == m_rtree) {
-        m_rtree.reset(new Rtree);
+    std::call_once(m_rtree.flag, [&] {
+        auto rtree = std::make_unique<Rtree>();
         const auto & prisms = m_model->m_prisms;
         const auto & triangulation = *m_model->GetLayerPrismTemplate(0);
         for (size_t i = 0; i < prisms.size(); ++i) {
             const auto & prism = prisms.at(i);
             const auto & element = m_model->GetPrismElement(prism.layer, prism.element);
             auto point = tri::TriangulationUtility<EPoint2D>::GetCenter(triangulation, element.templateId).Cast<ECoord>();
-            m_rtree->insert(std::make_pair(point, i));
+            rtree->insert(std::make_pair(point, i));
         }
-    }
-    return m_rtree.get();
+        m_rtree.rtree = std::move(rtree);
+    });
+    return m_rtree.rtree.get();
 }
 
 ECAD_INLINE CPtr<EPrismThermalModelQuery::Rtree> EPrismThermalModelQuery::BuildLayerIndexTree(size_t layer) const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (auto iter = m_lyrRtrees.find(layer); iter != m_lyrRtrees.cend()) return iter->second.get();
-
-    auto rtree = std::make_shared<Rtree>();
-    const auto & prisms = m_model->m_prisms;
-    const auto & indexOffset = m_model->m_indexOffset;
-    const auto & triangulation = *m_model->GetLayerPrismTemplate(layer);
-    for (size_t i = indexOffset.at(layer); i < indexOffset.at(layer + 1); ++i) {
-        const auto & prism = prisms.at(i); { ECAD_ASSERT(layer == prism.layer) }
-        const auto & element = m_model->GetPrismElement(layer, prism.element);
-        auto point = tri::TriangulationUtility<EPoint2D>::GetCenter(triangulation, element.templateId).Cast<ECoord>();
-        rtree->insert(std::make_pair(point, i));
-    }
-    return m_lyrRtrees.emplace(layer, rtree).first->second.get();
+    ECAD_ASSERT(layer < m_lyrRtrees.size())
+    auto & index = m_lyrRtrees[layer];
+    std::call_once(index.flag, [&] {
+        auto rtree = std::make_unique<Rtree>();
+        const auto & prisms = m_model->m_prisms;
+        const auto & indexOffset = m_model->m_indexOffset;
+        const auto & triangulation = *m_model->GetLayerPrismTemplate(layer);
+        for (size_t i = indexOffset.at(layer); i < indexOffset.at(layer + 1); ++i) {
+            const auto & prism = prisms.at(i); { ECAD_ASSERT(layer == prism.layer) }
+            const auto & element = m_model->GetPrismElement(layer, prism.element);
+            auto point = tri::TriangulationUtility<EPoint2D>::GetCenter(triangulation, element.templateId).Cast<ECoord>();
+            rtree->insert(std::make_pair(point, i));
+        }
+        index.rtree = std::move(rtree);
+    });
+    return index.rtree.get();
 }
 
 }//namespace utils
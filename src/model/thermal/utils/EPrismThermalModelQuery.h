@@ -1,6 +1,7 @@
 #pragma once
 #include "basic/ECadCommon.h"
 #include <boost/geometry/index/rtree.hpp>
+#include <mutex>
 
 namespace ecad {
 namespace model {
@@ -20,14 +21,19 @@ public:
     size_t NearestLayer(EFloat height) const;
 
 protected:
+    ///@brief each tree is built once on first use, different layers build concurrently and readers of a built tree never block
+    struct IndexTree
+    {
+        std::once_flag flag;
+        UPtr<Rtree> rtree{nullptr};
+    };
     CPtr<Rtree> BuildIndexTree() const;
     CPtr<Rtree> BuildLayerIndexTree(size_t layer) const;
 protected:
     CPtr<EPrismThermalModel> m_model{nullptr};
 
-    mutable std::mutex m_mutex;
-    mutable UPtr<Rtree> m_rtree{nullptr};
-    mutable std::unordered_map<size_t, SPtr<Rtree> > m_lyrRtrees;
+    mutable IndexTree m_rtree;
+    mutable std::vector<IndexTree> m_lyrRtrees;//sized to the model layers on construction, never resized
 };
 } // namespace utils
 } // namespace model
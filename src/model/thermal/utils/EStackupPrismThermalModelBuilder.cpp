@@ -3,14 +3,76 @@
 #include "EStackupPrismThermalModelQuery.h"
 #include "model/geometry/ELayerCutModel.h"
 
-#include "generic/geometry/BooleanOperation.hpp"
 #include "generic/thread/ThreadPool.hpp"
+#include <array>
 
 namespace ecad::model::utils {
+namespace detail {
+using FVertex = std::array<EFloat, 2>;
+using FTriangle = std::array<FVertex, 3>;
+
+//twice the signed area of (a, b, c), positive if counterclockwise
+ECAD_ALWAYS_INLINE EFloat Cross(const FVertex & a, const FVertex & b, const FVertex & c)
+{
+    return (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+}
+
+ECAD_INLINE EFloat Area(const FVertex * polygon, size_t size)
+{
+    if (size < 3) return 0;
+    EFloat area = 0;
+    for (size_t i = 0, j = size - 1; i < size; j = i++)
+        area += polygon[j][0] * polygon[i][1] - polygon[i][0] * polygon[j][1];
+    return 0.5 * std::abs(area);
+}
+
+//inside or on the boundary of the counterclockwise triangle t
+ECAD_INLINE bool Contains(const FTriangle & t, const FVertex & v)
+{
+    return Cross(t[0], t[1], v) >= 0 && Cross(t[1], t[2], v) >= 0 && Cross(t[2], t[0], v) >= 0;
+}
+
+//overlap area of two counterclockwise triangles by convex clipping, zero if they only touch
+ECAD_INLINE EFloat TriangleIntersectArea(const FTriangle & t1, const FTriangle & t2)
+{
+    //identical or nested triangles, the common case between layers meshed from the same outlines
+    if (Contains(t2, t1[0]) && Contains(t2, t1[1]) && Contains(t2, t1[2])) return Area(t1.data(), 3);
+    if (Contains(t1, t2[0]) && Contains(t1, t2[1]) && Contains(t1, t2[2])) return Area(t2.data(), 3);
+
+    //sutherland-hodgman, a convex polygon gains at most one vertex per clip edge,
+    //the buffer holds the worst case of round-off sign flips which at most double it per edge
+    std::array<FVertex, 24> buffer[2];
+    std::copy(t1.begin(), t1.end(), buffer[0].begin());
+    size_t size = 3, curr = 0;
+    for (size_t e = 0; e < 3 && size > 0; ++e) {
+        const auto & e0 = t2[e];
+        const auto & e1 = t2[(e + 1) % 3];
+        const auto & input = buffer[curr];
+        auto & output = buffer[curr ^ 1];
+        size_t count = 0;
+        for (size_t i = 0, j = size - 1; i < size; j = i++) {
+            const auto & p = input[j];
+            const auto & q = input[i];
+            auto dp = Cross(e0, e1, p), dq = Cross(e0, e1, q);
+            if ((dp < 0) != (dq < 0)) {
+                auto t = dp / (dp - dq);
+                output[count++] = FVertex{p[0] + t * (q[0] - p[0]), p[1] + t * (q[1] - p[1])};
+            }
+            if (dq >= 0) output[count++] = q;
+        }
+        size = count;
+        curr ^= 1;
+    }
+    //triangles sharing an edge or a vertex leave a degenerate polygon
+    auto area = Area(buffer[curr].data(), size);
+    return area > std::numeric_limits<EFloat>::epsilon() * std::min(Area(t1.data(), 3), Area(t2.data(), 3)) ? area : 0;
+}
+
+} // namespace detail
+
 ECAD_INLINE EStackupPrismThermalModelBuilder::EStackupPrismThermalModelBuilder(Ptr<EStackupPrismThermalModel> model)
  : m_model(model)
 {
-    m_query.reset(new EStackupPrismThermalModelQuery(m_model));
 }
 
 ECAD_INLINE EStackupPrismThermalModelBuilder::~EStackupPrismThermalModelBuilder()
@@ -48,6 +110,8 @@ ECAD_INLINE void EStackupPrismThermalModelBuilder::BuildPrismModel(EFloat scaleH
         }
     }
 
+    //layer trees are built on first use, the per layer tasks below build the trees of their adjacent layers concurrently
+    m_query.reset(new EStackupPrismThermalModelQuery(m_model, true));
     if (threads > 1) {
         generic::thread::ThreadPool pool(threads);
         const auto & offset = m_model->m_indexOffset;
@@ -133,11 +197,16 @@ ECAD_INLINE void EStackupPrismThermalModelBuilder::AddBondWiresFromLayerCutModel
 
 ECAD_INLINE EFloat EStackupPrismThermalModelBuilder::GetIntersectArea(const ETriangle2D & t1, const ETriangle2D & t2)
 {
-    EFloat area = 0;
-    std::vector<EPolygonData> output;
-    generic::geometry::boolean::Intersect(t1, t2, output);
-    std::for_each(output.begin(), output.end(), [&area](const EPolygonData & p) { area += p.Area(); });
-    return area;
+    using namespace detail;
+    auto toTriangle = [](const ETriangle2D & t) {
+        FTriangle triangle;
+        for (size_t i = 0; i < 3; ++i)
+            triangle[i] = FVertex{EFloat(t[i][0]), EFloat(t[i][1])};
+        //counterclockwise, inside is the left side of each edge
+        if (Cross(triangle[0], triangle[1], triangle[2]) < 0) std::swap(triangle[1], triangle[2]);
+        return triangle;
+    };
+    return TriangleIntersectArea(toTriangle(t1), toTriangle(t2));
 }
 
 } // namespace ecad::model::utils
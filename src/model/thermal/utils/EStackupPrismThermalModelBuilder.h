@@ -18,6 +18,7 @@ public:
     void BuildPrismInstanceTopBotNeighbors(size_t start, size_t end);
 
     void AddBondWiresFromLayerCutModel(CPtr<ELayerCutModel> lcm);
+    ///@brief overlap area of two triangles in coords, zero if they only touch
     static EFloat GetIntersectArea(const ETriangle2D & t1, const ETriangle2D & t2);
 protected:
     Ptr<EStackupPrismThermalModel> m_model;
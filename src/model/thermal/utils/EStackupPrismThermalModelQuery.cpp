@@ -3,7 +3,7 @@
 #include "EDataMgr.h"
 namespace ecad::model::utils {
 ECAD_INLINE EStackupPrismThermalModelQuery::EStackupPrismThermalModelQuery(CPtr<EStackupPrismThermalModel> model, bool lazyBuild)
- : m_model(model)
+ : m_model(model), m_lyrRtrees(model->TotalLayers())
 {
     if (not lazyBuild) {
         generic::thread::ThreadPool pool(EDataMgr::Instance().Threads());
@@ -41,19 +41,22 @@ ECAD_INLINE void EStackupPrismThermalModelQuery::SearchPrismInstances(size_t lay
 
 ECAD_INLINE CPtr<EStackupPrismThermalModelQuery::Rtree> EStackupPrismThermalModelQuery::BuildLayerIndexTree(size_t layer) const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (auto iter = m_lyrRtrees.find(layer); iter != m_lyrRtrees.cend()) return iter->second.get();
-    auto rtree = std::make_shared<Rtree>();
-    const auto & prisms = m_model->m_prisms;
-    const auto & indexOffset = m_model->m_indexOffset;
-    const auto & triangulation = *m_model->GetLayerPrismTemplate(layer);
-    for (size_t i = indexOffset.at(layer); i < indexOffset.at(layer + 1); ++i) {
-        const auto & prism = prisms.at(i); { ECAD_ASSERT(layer == prism.layer) }
-        const auto & element = m_model->GetPrismElement(prism.layer, prism.element);
-        auto box = tri::TriangulationUtility<EPoint2D>::GetBondBox(triangulation, element.templateId);
-        rtree->insert(std::make_pair(std::move(box), i));
-    }
-    return m_lyrRtrees.emplace(layer, rtree).first->second.get();
+    ECAD_ASSERT(layer < m_lyrRtrees.size())
+    auto & index = m_lyrRtrees[layer];
+    std::call_once(index.flag, [&] {
+        auto rtree = std::make_unique<Rtree>();
+        const auto & prisms = m_model->m_prisms;
+        const auto & indexOffset = m_model->m_indexOffset;
+        const auto & triangulation = *m_model->GetLayerPrismTemplate(layer);
+        for (size_t i = indexOffset.at(layer); i < indexOffset.at(layer + 1); ++i) {
+            const auto & prism = prisms.at(i); { ECAD_ASSERT(layer == prism.layer) }
+            const auto & element = m_model->GetPrismElement(prism.layer, prism.element);
+            auto box = tri::TriangulationUtility<EPoint2D>::GetBondBox(triangulation, element.templateId);
+            rtree->insert(std::make_pair(std::move(box), i));
+        }
+        index.rtree = std::move(rtree);
+    });
+    return index.rtree.get();
 }
 
 ECAD_INLINE void EStackupPrismThermalModelQuery::SearchNearestPrismInstances(size_t layer, const EPoint2D & pt, size_t k, std::vector<RtVal> & results) const
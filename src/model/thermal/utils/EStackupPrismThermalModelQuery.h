@@ -1,6 +1,7 @@
 #pragma once
 #include "basic/ECadCommon.h"
 #include <boost/geometry/index/rtree.hpp>
+#include <mutex>
 
 namespace ecad {
 namespace model {
@@ -23,11 +24,16 @@ public:
     void SearchNearestPrismInstances(size_t layer, const EPoint2D & pt, size_t k, std::vector<RtVal> & results) const;
     size_t NearestLayer(EFloat height) const;
 protected:
+    ///@brief built once on first use, different layers build concurrently and readers of a built tree never block
+    struct IndexTree
+    {
+        std::once_flag flag;
+        UPtr<Rtree> rtree{nullptr};
+    };
     CPtr<Rtree> BuildLayerIndexTree(size_t layer) const;
 protected:
-    mutable std::mutex m_mutex;
     CPtr<EStackupPrismThermalModel> m_model{nullptr};
-    mutable std::unordered_map<size_t, SPtr<Rtree> > m_lyrRtrees;//todo reuse imprint layer's tree
+    mutable std::vector<IndexTree> m_lyrRtrees;//sized to the model layers on construction, never resized, todo reuse imprint layer's tree
 };
 } // namespace utils
 } // namespace model
@@ -85,6 +85,35 @@ ECAD_API EPair<EFloat, EFloat> EThermalSimulation::RunTransientSimulation(const
     return {invalidFloat, invalidFloat};;
 }
 
+ECAD_API std::vector<EPair<EFloat, EFloat> > EThermalSimulation::RunStaticSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const
+{
+    ECAD_TRACE("run static thermal sweep of %1% cases at %2%", cases.size(), m_setup.workDir);
+    temperatures.clear();
+    if (nullptr == m_model) {
+        ECAD_ASSERT(false)
+        return {};
+    }
+    auto modelType = m_model->GetModelType();
+    switch (modelType) {
+    case EModelType::ThermalGrid : {
+        if (auto grid = dynamic_cast<CPtr<EGridThermalModel> >(m_model); grid)
+            return EGridThermalSimulator(grid, m_setup).RunStaticSweep(cases, temperatures);
+    }
+    case EModelType::ThermalPrism : {
+        if (auto prism = dynamic_cast<CPtr<EPrismThermalModel> >(m_model); prism)
+            return EPrismThermalSimulator(prism, m_setup).RunStaticSweep(cases, temperatures);
+    }
+    case EModelType::ThermalStackupPrism : {
+        if (auto prism = dynamic_cast<CPtr<EStackupPrismThermalModel> >(m_model); prism)
+            return EStackupPrismThermalSimulator(prism, m_setup).RunStaticSweep(cases, temperatures);
+    }
+    default :
+        ECAD_ASSERT(false)
+        return {};
+    }
+    return {};
+}
+
 ECAD_API EThermalSimulator::EThermalSimulator(CPtr<IModel> model, const EThermalSimulationSetup & setup)
  : m_model(model), m_setup(setup)
 {
@@ -123,6 +152,20 @@ ECAD_API EPair<EFloat, EFloat> EGridThermalSimulator::RunTransientSimulation(con
     return solver.Solve();
 }
 
+ECAD_API std::vector<EPair<EFloat, EFloat> > EGridThermalSimulator::RunStaticSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const
+{
+    ECAD_EFFICIENCY_TRACK("grid thermal static sweep")
+    auto model = dynamic_cast<CPtr<EGridThermalModel> >(m_model);
+    auto setup = dynamic_cast<CPtr<EThermalStaticSimulationSetup> >(&m_setup);
+    if (nullptr == model || nullptr == setup) return {};
+
+    EGridThermalNetworkStaticSolver solver(*model);
+    solver.settings = setup->settings;
+    solver.settings.workDir = setup->workDir;
+    model->SearchElementIndices(setup->monitors, solver.settings.probs);
+    return solver.SolveSweep(cases, temperatures);
+}
+
 ECAD_API EPrismThermalSimulator::EPrismThermalSimulator(CPtr<EPrismThermalModel> model, const EThermalSimulationSetup & setup)
  : EThermalSimulator(model, setup)
 {
@@ -157,6 +200,20 @@ ECAD_API EPair<EFloat, EFloat> EPrismThermalSimulator::RunTransientSimulation(co
     return solver.Solve();
 }
 
+ECAD_API std::vector<EPair<EFloat, EFloat> > EPrismThermalSimulator::RunStaticSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const
+{
+    ECAD_EFFICIENCY_TRACK("prism thermal static sweep")
+    auto model = dynamic_cast<CPtr<EPrismThermalModel> >(m_model);
+    auto setup = dynamic_cast<CPtr<EThermalStaticSimulationSetup> >(&m_setup);
+    if (nullptr == model || nullptr == setup) return {};
+
+    EPrismThermalNetworkStaticSolver solver(*model);
+    solver.settings = setup->settings;
+    solver.settings.workDir = setup->workDir;
+    model->SearchElementIndices(setup->monitors, solver.settings.probs);
+    return solver.SolveSweep(cases, temperatures);
+}
+
 ECAD_API EStackupPrismThermalSimulator::EStackupPrismThermalSimulator(CPtr<EStackupPrismThermalModel> model, const EThermalSimulationSetup & setup)
  : EThermalSimulator(model, setup)
 {
@@ -191,4 +248,18 @@ ECAD_API EPair<EFloat, EFloat> EStackupPrismThermalSimulator::RunTransientSimula
     return solver.Solve();
 }
 
+ECAD_API std::vector<EPair<EFloat, EFloat> > EStackupPrismThermalSimulator::RunStaticSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const
+{
+    ECAD_EFFICIENCY_TRACK("stackup prism thermal static sweep")
+    auto model = dynamic_cast<CPtr<EStackupPrismThermalModel> >(m_model);
+    auto setup = dynamic_cast<CPtr<EThermalStaticSimulationSetup> >(&m_setup);
+    if (nullptr == model || nullptr == setup) return {};
+
+    EStackupPrismThermalNetworkStaticSolver solver(*model);
+    solver.settings = setup->settings;
+    solver.settings.workDir = setup->workDir;
+    model->SearchElementIndices(setup->monitors, solver.settings.probs);
+    return solver.SolveSweep(cases, temperatures);
+}
+
 } // namespace ecad::simulation
\ No newline at end of file
@@ -17,6 +17,7 @@ public:
     virtual ~EThermalSimulation() = default;
     virtual EPair<EFloat, EFloat> RunStaticSimulation(std::vector<EFloat> & temperatures) const;
     virtual EPair<EFloat, EFloat> RunTransientSimulation(const EThermalTransientExcitation & excitation) const;
+    virtual std::vector<EPair<EFloat, EFloat> > RunStaticSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const;
 protected:
     CPtr<IModel> m_model{nullptr};
     const EThermalSimulationSetup & m_setup;
@@ -28,6 +29,7 @@ public:
     virtual ~EThermalSimulator() = default;
     virtual EPair<EFloat, EFloat> RunStaticSimulation(std::vector<EFloat> & temperatures) const = 0;
     virtual EPair<EFloat, EFloat> RunTransientSimulation(const EThermalTransientExcitation & excitation) const = 0;
+    virtual std::vector<EPair<EFloat, EFloat> > RunStaticSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const = 0;
 protected:
     EThermalSimulator(CPtr<IModel> model, const EThermalSimulationSetup & setup);
     CPtr<IModel> m_model{nullptr};
@@ -41,6 +43,7 @@ public:
     virtual ~EGridThermalSimulator() = default;
     EPair<EFloat, EFloat> RunStaticSimulation(std::vector<EFloat> & temperatures) const override;
     EPair<EFloat, EFloat> RunTransientSimulation(const EThermalTransientExcitation & excitation) const override;
+    std::vector<EPair<EFloat, EFloat> > RunStaticSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const override;
 };
 
 class ECAD_API EPrismThermalSimulator : public EThermalSimulator
@@ -50,6 +53,7 @@ public:
     virtual ~EPrismThermalSimulator() = default;
     EPair<EFloat, EFloat> RunStaticSimulation(std::vector<EFloat> & temperatures) const override;
     EPair<EFloat, EFloat> RunTransientSimulation(const EThermalTransientExcitation & excitation) const override;
+    std::vector<EPair<EFloat, EFloat> > RunStaticSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const override;
 };
 
 class ECAD_API EStackupPrismThermalSimulator : public EThermalSimulator
@@ -59,6 +63,7 @@ public:
     virtual ~EStackupPrismThermalSimulator() = default;
     EPair<EFloat, EFloat> RunStaticSimulation(std::vector<EFloat> & temperatures) const override;
     EPair<EFloat, EFloat> RunTransientSimulation(const EThermalTransientExcitation & excitation) const override;
+    std::vector<EPair<EFloat, EFloat> > RunStaticSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const override;
 };
 }//namespace simulations
 }//namespace ecad
\ No newline at end of file
@@ -48,9 +48,14 @@ ECAD_INLINE bool EThermalNetworkStaticSolver::Solve(const typename ThermalNetwor
     Scalar residual = 0;
     size_t iteration = 0;
     size_t maxIteration = traits::EThermalModelTraits<Model>::NeedIteration(model) ? settings.iteration : 1;
+    using namespace thermal::solver;
+    ThermalNetworkStaticSolveSession<Scalar> session(static_cast<int>(settings.solverType));
+    UPtr<typename ThermalNetworkBuilder::Network> network;
     do {
         std::vector<Scalar> prevRes(results);
-        auto network = builder.Build(prevRes);
+        //later iterations rescale the temperature dependent values of the first network in place
+        if (nullptr == network || not builder.Update(prevRes, *network, settings.threads))
+            network = builder.Build(prevRes, settings.threads);
         if (nullptr == network) return false;
         ECAD_TRACE("total nodes: %1%", network->Size());
         ECAD_TRACE("total joule heat: %1%w", builder.summary.jouleHeat);
@@ -62,14 +67,13 @@ ECAD_INLINE bool EThermalNetworkStaticSolver::Solve(const typename ThermalNetwor
             matDir = settings.workDir + ECAD_SEPS + "iteration_" + std::to_string(iteration);
         }
 
-        using namespace thermal::solver;
-        ThermalNetworkSolver<Scalar> solver(*network, static_cast<int>(settings.solverType));
-        solver.Solve(envT, results, matDir);
+        if (not session.Solve(*network, envT, results, matDir)) return false;
 
         residual = CalculateResidual(results, prevRes, settings.maximumRes);
         ECAD_TRACE("P-T Iteration: %1%, Residual: %2%.", ++iteration, residual);
         ECAD_TRACE("max T: %1%C", ETemperature::Kelvins2Celsius(*std::max_element(results.begin(), results.end())));
     } while (residual > settings.residual && --maxIteration > 0);
+    ECAD_TRACE("symbolic analysis: %1%, numeric factorization: %2%", session.Analyzed(), session.Factorized());
 
     if (settings.envTemperature.unit == ETemperatureUnit::Celsius) 
         std::for_each(results.begin(), results.end(), [](auto & t){ t = ETemperature::Kelvins2Celsius(t); });
@@ -87,10 +91,82 @@ ECAD_INLINE bool EThermalNetworkStaticSolver::Solve(const typename ThermalNetwor
     return true;   
 }
 
+template <typename ThermalNetworkBuilder>
+ECAD_INLINE bool EThermalNetworkStaticSolver::SolveSweep(const typename ThermalNetworkBuilder::ModelType & model, const std::vector<EThermalStaticSweepCase> & cases,
+                                                        std::vector<EPair<EFloat, EFloat> > & ranges, std::vector<std::vector<EFloat> > & temperatures) const
+{
+    ranges.assign(cases.size(), {invalidFloat, invalidFloat});
+    temperatures.assign(cases.size(), {});
+    if (cases.empty()) return true;
+
+    //material properties are evaluated once at the environment temperature of the settings, so the sweep is linear
+    auto envT = settings.envTemperature.inKelvins();
+    ThermalNetworkBuilder builder(model);
+    using Model = typename ThermalNetworkBuilder::ModelType;
+    std::vector<Scalar> iniT(traits::EThermalModelTraits<Model>::Size(model), envT);
+    auto network = builder.Build(iniT, settings.threads);
+    if (nullptr == network) return false;
+    ECAD_TRACE("sweep %1% cases on %2% nodes", cases.size(), network->Size());
+
+    //cases with the same htc scale share one conductance matrix
+    std::vector<EFloat> htcScales;
+    std::vector<std::vector<size_t> > groups;
+    for (size_t i = 0; i < cases.size(); ++i) {
+        auto iter = std::find_if(htcScales.begin(), htcScales.end(), [&](auto scale) { return math::EQ(scale, cases.at(i).htcScale); });
+        if (iter == htcScales.end()) {
+            htcScales.emplace_back(cases.at(i).htcScale);
+            groups.emplace_back();
+            iter = std::prev(htcScales.end());
+        }
+        groups.at(std::distance(htcScales.begin(), iter)).emplace_back(i);
+    }
+
+    using namespace thermal::solver;
+    using Network = typename ThermalNetworkBuilder::Network;
+    for (size_t g = 0; g < groups.size(); ++g) {
+        //one factorization per group, the htc scale goes into the assembly so all groups share the network,
+        //the rhs of all cases are solved together as columns of one matrix
+        const auto & indices = groups.at(g);
+        const Scalar htcScale = htcScales.at(g);
+        using Session = ThermalNetworkStaticSolveSession<Scalar>;
+        Session session(static_cast<int>(settings.solverType));
+        if (not session.Prepare(*network, htcScale)) return false;
+        typename Session::DenseMatrix B(network->Size(), indices.size()), X;
+        for (size_t k = 0; k < indices.size(); ++k) {
+            const auto & sweepCase = cases.at(indices.at(k));
+            Scalar refT = sweepCase.envTemperature.inKelvins();
+            for (size_t n = 0; n < network->Size(); ++n) {
+                Scalar hf = network->GetHF(n);
+                if (auto scen = network->GetScenario(n); hf != 0 && scen != Network::noScenario) {
+                    if (auto iter = sweepCase.powerScales.find(scen); iter != sweepCase.powerScales.cend())
+                        hf *= iter->second;
+                }
+                B(n, k) = hf + htcScale * network->GetHTC(n) * refT;
+            }
+        }
+        session.Solve(B, X, settings.threads);
+
+        for (size_t k = 0; k < indices.size(); ++k) {
+            auto index = indices.at(k);
+            bool inCelsius = cases.at(index).envTemperature.unit == ETemperatureUnit::Celsius;
+            auto toUnit = [inCelsius](Scalar t) -> EFloat { return inCelsius ? ETemperature::Kelvins2Celsius(t) : t; };
+            ranges[index] = {toUnit(X.col(k).minCoeff()), toUnit(X.col(k).maxCoeff())};
+            auto & probTs = temperatures[index];
+            probTs.resize(settings.probs.size());
+            for (size_t p = 0; p < settings.probs.size(); ++p)
+                probTs[p] = toUnit(X(settings.probs.at(p), k));
+        }
+    }
+    return true;
+}
+
 using StaticSolverNumType = typename EThermalNetworkStaticSolver::Scalar;
 ECAD_INLINE template bool EThermalNetworkStaticSolver::Solve<EGridThermalNetworkBuilder<StaticSolverNumType>>(const EGridThermalModel & model, std::vector<StaticSolverNumType> & results) const;
 ECAD_INLINE template bool EThermalNetworkStaticSolver::Solve<EPrismThermalNetworkBuilder<StaticSolverNumType>>(const EPrismThermalModel & model, std::vector<StaticSolverNumType> & results) const;
 ECAD_INLINE template bool EThermalNetworkStaticSolver::Solve<EStackupPrismThermalNetworkBuilder<StaticSolverNumType>>(const EStackupPrismThermalModel & model, std::vector<StaticSolverNumType> & results) const;
+ECAD_INLINE template bool EThermalNetworkStaticSolver::SolveSweep<EGridThermalNetworkBuilder<StaticSolverNumType>>(const EGridThermalModel & model, const std::vector<EThermalStaticSweepCase> & cases, std::vector<EPair<EFloat, EFloat> > & ranges, std::vector<std::vector<EFloat> > & temperatures) const;
+ECAD_INLINE template bool EThermalNetworkStaticSolver::SolveSweep<EPrismThermalNetworkBuilder<StaticSolverNumType>>(const EPrismThermalModel & model, const std::vector<EThermalStaticSweepCase> & cases, std::vector<EPair<EFloat, EFloat> > & ranges, std::vector<std::vector<EFloat> > & temperatures) const;
+ECAD_INLINE template bool EThermalNetworkStaticSolver::SolveSweep<EStackupPrismThermalNetworkBuilder<StaticSolverNumType>>(const EStackupPrismThermalModel & model, const std::vector<EThermalStaticSweepCase> & cases, std::vector<EPair<EFloat, EFloat> > & ranges, std::vector<std::vector<EFloat> > & temperatures) const;
 
 EThermalNetworkTransientSolver::EThermalNetworkTransientSolver(const EThermalTransientExcitation & excitation)
  : settings("", 1), m_excitation(excitation)
@@ -108,44 +184,58 @@ ECAD_INLINE bool EThermalNetworkTransientSolver::Solve(const typename ThermalNet
     ThermalNetworkBuilder builder(model);
     UPtr<typename ThermalNetworkBuilder::Network> network;
     using Model = typename ThermalNetworkBuilder::ModelType;
-    
+    using StateType = std::vector<Scalar>;
+
     size_t steps{0};
     Samples<Scalar> samples;
     TimeWindow<Scalar> window(settings.duration - settings.samplingWindow, settings.duration, settings.minSamplingInterval);
     ECAD_TRACE("duration: %1%, step: %2%, abs error: %3%, rel error: %4%", settings.duration, settings.step, settings.absoluteError, settings.relativeError);
     if (0 == settings.mor.order) {
-        ECAD_EFFICIENCY_TRACK("transient orig")
-        using TransSolver = ThermalNetworkTransientSolver<Scalar>;
-        using StateType = typename TransSolver::StateType;
-        using Sampler = typename TransSolver::Sampler;
         StateType initT(traits::EThermalModelTraits<Model>::Size(model), envT);
-        if (settings.temperatureDepend) {
-            Scalar time = 0;
-            while (time < settings.duration) {
+        network = builder.Build(initT, settings.threads);
+        if (nullptr == network) return false;
+        //one solver for the whole duration, temperature dependent properties are refreshed every settings.step
+        //by updating the network in place, so the implicit solver keeps its history and symbolic analyses,
+        //dt is the fixed step and the initial step of adaptive solves within one refresh interval
+        auto integrate = [&](auto & solver, Scalar dt) {
+            using Sampler = typename std::decay_t<decltype(solver)>::Sampler;
+            if (not settings.temperatureDepend) {
+                Sampler sampler(solver, samples, initT, window, settings.duration, settings.verbose);
+                steps = settings.adaptive ?
+                        solver.SolveAdaptive(initT, Scalar{0}, settings.duration, settings.step, settings.absoluteError, settings.relativeError, std::move(sampler), &m_excitation) :
+                        solver.Solve(initT, Scalar{0}, settings.duration, dt, settings.absoluteError, settings.relativeError, std::move(sampler), &m_excitation);
+                return;
+            }
+            for (Scalar time = 0; time < settings.duration; time += settings.step) {
                 if (settings.verbose)
                     ECAD_TRACE("time:%1%/%2%", time, settings.duration);
-                auto network = builder.Build(initT);
-                TransSolver solver(*network, envT, settings.probs);
+                if (time > 0) {
+                    if (not builder.Update(initT, *network, settings.threads))
+                        network = builder.Build(initT, settings.threads);
+                    solver.Update(*network);
+                }
                 Sampler sampler(solver, samples, initT, window, settings.duration, settings.verbose);
                 steps += settings.adaptive ?
-                         solver.SolveAdaptive(initT, time, settings.step, settings.minSamplingInterval, settings.absoluteError, settings.relativeError, std::move(sampler), &m_excitation) :
-                         solver.Solve(initT, time, settings.step, settings.minSamplingInterval, settings.absoluteError, settings.relativeError, std::move(sampler), &m_excitation);
-                time += settings.step;
+                         solver.SolveAdaptive(initT, time, settings.step, dt, settings.absoluteError, settings.relativeError, std::move(sampler), &m_excitation) :
+                         solver.Solve(initT, time, settings.step, dt, settings.absoluteError, settings.relativeError, std::move(sampler), &m_excitation);
             }
+        };
+        if (EThermalTransientIntegrator::Explicit != settings.integrator) {
+            ECAD_EFFICIENCY_TRACK("transient implicit")
+            ThermalNetworkImplicitTransientSolver<Scalar> solver(*network, envT, settings.probs, static_cast<ImplicitMethod>(settings.integrator));
+            integrate(solver, Scalar(settings.step));
+            ECAD_TRACE("implicit steps: %1%, factorizations: %2%", steps, solver.Factorized());
         }
         else {
-            auto network = builder.Build(initT);
-            TransSolver solver(*network, envT, settings.probs);
-            Sampler sampler(solver, samples, initT, window, settings.duration, settings.verbose);
-            steps = settings.adaptive ?
-                    solver.SolveAdaptive(initT, Scalar{0}, settings.duration, settings.step, settings.absoluteError, settings.relativeError, std::move(sampler), &m_excitation) :
-                    solver.Solve(initT, Scalar{0}, settings.duration, settings.minSamplingInterval, settings.absoluteError, settings.relativeError, std::move(sampler), &m_excitation);
+            ECAD_EFFICIENCY_TRACK("transient orig")
+            //the explicit stepper is only stable for small steps, it keeps stepping at the sampling interval
+            ThermalNetworkTransientSolver<Scalar> solver(*network, envT, settings.probs);
+            integrate(solver, Scalar(settings.minSamplingInterval));
         }
     }
     else {
         ECAD_EFFICIENCY_TRACK("transient mor")
         using TransSolver = ThermalNetworkReducedTransientSolver<Scalar>;
-        using StateType = typename TransSolver::StateType;
         using Sampler = typename TransSolver::Sampler;
         StateType initT(traits::EThermalModelTraits<Model>::Size(model), envT);
         if (settings.temperatureDepend) {
@@ -153,7 +243,9 @@ ECAD_INLINE bool EThermalNetworkTransientSolver::Solve(const typename ThermalNet
             while (time < settings.duration) {
                 ECAD_TRACE("time:%1%/%2%", time, settings.duration);
                 StateType initState;
-                auto network = builder.Build(initT);
+                if (nullptr == network || not builder.Update(initT, *network, settings.threads))
+                    network = builder.Build(initT, settings.threads);
+                if (nullptr == network) return false;
                 TransSolver solver(*network, envT, settings.probs, settings.mor.order, {}, {});
                 if (not solver.Im().Input2State(initT, initState)) return false;
                 Sampler sampler(solver, samples, initState, window, settings.duration, settings.verbose);
@@ -167,7 +259,8 @@ ECAD_INLINE bool EThermalNetworkTransientSolver::Solve(const typename ThermalNet
         }
         else {
             StateType initState;
-            auto network = builder.Build(initT);
+            network = builder.Build(initT, settings.threads);
+            if (nullptr == network) return false;
             TransSolver solver(*network, envT, settings.probs, settings.mor.order, settings.mor.romLoadFile, settings.mor.romSaveFile);
             if (not solver.Im().Input2State(initT, initState)) return false;
             Sampler sampler(solver, samples, initState, window, settings.duration, settings.verbose);
@@ -256,6 +349,14 @@ ECAD_INLINE EPair<EFloat, EFloat> EGridThermalNetworkStaticSolver::Solve(std::ve
     return {minT, maxT};
 }
 
+ECAD_INLINE std::vector<EPair<EFloat, EFloat> > EGridThermalNetworkStaticSolver::SolveSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const
+{
+    ECAD_EFFICIENCY_TRACK("grid thermal network static sweep")
+    std::vector<EPair<EFloat, EFloat> > ranges;
+    EThermalNetworkStaticSolver::template SolveSweep<EGridThermalNetworkBuilder<Scalar>>(m_model, cases, ranges, temperatures);
+    return ranges;
+}
+
 ECAD_INLINE EGridThermalNetworkTransientSolver::EGridThermalNetworkTransientSolver(const EGridThermalModel & model, const EThermalTransientExcitation & excitation)
  : EGridThermalNetworkSolver(model), EThermalNetworkTransientSolver(excitation)
 {
@@ -295,13 +396,21 @@ ECAD_INLINE EPair<EFloat, EFloat> EPrismThermalNetworkStaticSolver::Solve(std::v
         temperatures[i] = results.at(settings.probs.at(i));
 
     if (settings.dumpHotmaps) {
-        auto hotmapFile = settings.workDir + ECAD_SEPS + "hotmap.vtk";
-        ECAD_TRACE("dump vtk hotmap: %1%", hotmapFile);
-        io::GenerateVTKFile<Scalar>(hotmapFile, m_model, &results);
+        auto hotmapFile = settings.workDir + ECAD_SEPS + "hotmap.vtu";
+        ECAD_TRACE("dump vtu hotmap: %1%", hotmapFile);
+        io::GenerateVTUFile<Scalar>(hotmapFile, m_model, &results);
     }
     return {minT, maxT};
 }
 
+ECAD_INLINE std::vector<EPair<EFloat, EFloat> > EPrismThermalNetworkStaticSolver::SolveSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const
+{
+    ECAD_EFFICIENCY_TRACK("prism thermal network static sweep")
+    std::vector<EPair<EFloat, EFloat> > ranges;
+    EThermalNetworkStaticSolver::template SolveSweep<EPrismThermalNetworkBuilder<Scalar>>(m_model, cases, ranges, temperatures);
+    return ranges;
+}
+
 ECAD_INLINE EPrismThermalNetworkTransientSolver::EPrismThermalNetworkTransientSolver(const EPrismThermalModel & model, const EThermalTransientExcitation & excitation)
  : EPrismThermalNetworkSolver(model), EThermalNetworkTransientSolver(excitation)
 {
@@ -342,13 +451,21 @@ ECAD_INLINE EPair<EFloat, EFloat> EStackupPrismThermalNetworkStaticSolver::Solve
         temperatures[i] = results.at(settings.probs.at(i));
 
     if (settings.dumpHotmaps) {
-        auto hotmapFile = settings.workDir + ECAD_SEPS + "hotmap.vtk";
-        ECAD_TRACE("dump vtk hotmap: %1%", hotmapFile);
-        io::GenerateVTKFile(hotmapFile, m_model, &results);
+        auto hotmapFile = settings.workDir + ECAD_SEPS + "hotmap.vtu";
+        ECAD_TRACE("dump vtu hotmap: %1%", hotmapFile);
+        io::GenerateVTUFile(hotmapFile, m_model, &results);
     }
     return {minT, maxT};
 }
 
+ECAD_INLINE std::vector<EPair<EFloat, EFloat> > EStackupPrismThermalNetworkStaticSolver::SolveSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const
+{
+    ECAD_EFFICIENCY_TRACK("stackup prism thermal network static sweep")
+    std::vector<EPair<EFloat, EFloat> > ranges;
+    EThermalNetworkStaticSolver::template SolveSweep<EStackupPrismThermalNetworkBuilder<Scalar>>(m_model, cases, ranges, temperatures);
+    return ranges;
+}
+
 ECAD_INLINE EStackupPrismThermalNetworkTransientSolver::EStackupPrismThermalNetworkTransientSolver(const EStackupPrismThermalModel & model, const EThermalTransientExcitation & excitation)
  : EStackupPrismThermalNetworkSolver(model), EThermalNetworkTransientSolver(excitation)
 {
@@ -22,6 +22,13 @@ public:
 
     template <typename ThermalNetworkBuilder>
     bool Solve(const typename ThermalNetworkBuilder::ModelType & model, std::vector<Scalar> & results) const;
+
+    ///@brief solves the cases on one network built at the environment temperature of the settings,
+    ///       cases sharing an htc scale are solved as the columns of one rhs matrix on a single factorization,
+    ///       per case outputs the [minT, maxT] range and the temperatures at settings.probs
+    template <typename ThermalNetworkBuilder>
+    bool SolveSweep(const typename ThermalNetworkBuilder::ModelType & model, const std::vector<EThermalStaticSweepCase> & cases,
+                    std::vector<EPair<EFloat, EFloat> > & ranges, std::vector<std::vector<EFloat> > & temperatures) const;
 };
 
 class ECAD_API EThermalNetworkTransientSolver : public EThermalNetworkSolver
@@ -55,6 +62,7 @@ public:
     explicit EGridThermalNetworkStaticSolver(const EGridThermalModel & model);
     virtual ~EGridThermalNetworkStaticSolver() = default;
     EPair<EFloat, EFloat> Solve(std::vector<EFloat> & temperatures) const;
+    std::vector<EPair<EFloat, EFloat> > SolveSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const;
 };
 
 class ECAD_API EGridThermalNetworkTransientSolver : public EGridThermalNetworkSolver, EThermalNetworkTransientSolver
@@ -83,6 +91,7 @@ public:
     explicit EPrismThermalNetworkStaticSolver(const EPrismThermalModel & model);
     virtual ~EPrismThermalNetworkStaticSolver() = default;
     EPair<EFloat, EFloat> Solve(std::vector<EFloat> & temperatures) const;
+    std::vector<EPair<EFloat, EFloat> > SolveSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const;
 };
 
 class ECAD_API EPrismThermalNetworkTransientSolver : public EPrismThermalNetworkSolver, EThermalNetworkTransientSolver
@@ -111,6 +120,7 @@ public:
     explicit EStackupPrismThermalNetworkStaticSolver(const EStackupPrismThermalModel & model);
     virtual ~EStackupPrismThermalNetworkStaticSolver() = default;
     EPair<EFloat, EFloat> Solve(std::vector<EFloat> & temperatures) const;
+    std::vector<EPair<EFloat, EFloat> > SolveSweep(const std::vector<EThermalStaticSweepCase> & cases, std::vector<std::vector<EFloat> > & temperatures) const;
 };
 
 class ECAD_API EStackupPrismThermalNetworkTransientSolver : public EStackupPrismThermalNetworkSolver, EThermalNetworkTransientSolver
@@ -0,0 +1,244 @@
+#pragma once
+#include <Eigen/SparseCore>
+#include <Eigen/SparseCholesky>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+namespace thermal::solver {
+
+///@brief smoothed aggregation algebraic multigrid for symmetric positive definite conductance matrices,
+///       meets the Eigen preconditioner interface, each solve applies one symmetric V-cycle so it can precondition CG
+template <typename Scalar>
+class SmoothedAggregationAMG
+{
+public:
+    using Index = Eigen::Index;
+    using Matrix = Eigen::SparseMatrix<Scalar, Eigen::RowMajor>;
+    using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+
+    struct Settings
+    {
+        Scalar strength = 0.08;//strong coupling threshold on the finest level, halved on each coarser level
+        Scalar relax = Scalar(4) / 3;//prolongator smoothing weight over the spectral radius estimate of D^-1 A
+        Index coarseSize = 500;//levels are added until the coarsest one is solved directly below this size
+        size_t maxLevels = 20;
+        size_t sweeps = 1;//Gauss-Seidel sweeps before and after the coarse correction
+    };
+
+    Settings settings;
+
+    SmoothedAggregationAMG() = default;
+
+    template <typename MatrixType>
+    explicit SmoothedAggregationAMG(const MatrixType & mat) { compute(mat); }
+
+    template <typename MatrixType>
+    SmoothedAggregationAMG & analyzePattern(const MatrixType &) { return *this; }
+
+    ///@brief rebuilds the hierarchy, aggregates depend on the coefficients so there is nothing to keep from the pattern
+    template <typename MatrixType>
+    SmoothedAggregationAMG & factorize(const MatrixType & mat)
+    {
+        Setup(Matrix(mat));
+        return *this;
+    }
+
+    template <typename MatrixType>
+    SmoothedAggregationAMG & compute(const MatrixType & mat) { return factorize(mat); }
+
+    template <typename Rhs>
+    Vector solve(const Rhs & b) const
+    {
+        Vector x = Vector::Zero(b.size());
+        if (not m_levels.empty()) Cycle(0, b, x);
+        return x;
+    }
+
+    Eigen::ComputationInfo info() const { return m_info; }
+
+    size_t Levels() const { return m_levels.size(); }
+    Index Rows(size_t level) const { return m_levels.at(level).A.rows(); }
+
+private:
+    struct Level
+    {
+        Matrix A;
+        Matrix P;
+        Matrix R;
+        Vector invDiag;
+    };
+
+    static constexpr Index undefined = -1;
+    static constexpr Index removed = -2;
+
+    void Setup(Matrix A)
+    {
+        m_levels.clear();
+        m_info = Eigen::Success;
+        A.makeCompressed();
+        m_levels.emplace_back(Level{std::move(A), {}, {}, {}});
+
+        Scalar eps = settings.strength;
+        while (true) {
+            auto & fine = m_levels.back();
+            fine.invDiag = fine.A.diagonal().cwiseInverse();
+            if (fine.A.rows() <= settings.coarseSize || m_levels.size() >= settings.maxLevels) break;
+
+            std::vector<Index> aggregates;
+            auto count = Aggregate(fine.A, eps, aggregates);
+            if (0 == count || count == fine.A.rows()) break;
+
+            fine.P = SmoothedProlongation(fine.A, eps, aggregates, count);
+            fine.R = fine.P.transpose();
+            Matrix AP = fine.A * fine.P;
+            Matrix coarse = fine.R * AP;
+            coarse.makeCompressed();
+            m_levels.emplace_back(Level{std::move(coarse), {}, {}, {}});
+            eps *= Scalar(0.5);
+        }
+
+        m_coarse.compute(Eigen::SparseMatrix<Scalar>(m_levels.back().A));
+        m_info = m_coarse.info();
+    }
+
+    ///@brief strong coupling test |a_ij| > eps * sqrt(|a_ii * a_jj|)
+    static bool isStrong(const Vector & diag, Index i, Index j, Scalar aij, Scalar eps)
+    {
+        return aij * aij > eps * eps * std::fabs(diag[i] * diag[j]);
+    }
+
+    ///@brief plain aggregation in three passes, returns the number of aggregates,
+    ///       nodes without strong neighbors are removed from the coarse space and left to the smoother
+    static Index Aggregate(const Matrix & A, Scalar eps, std::vector<Index> & aggregates)
+    {
+        const Index n = A.rows();
+        const Vector diag = A.diagonal();
+        std::vector<std::vector<Index> > strong(n);
+        for (Index i = 0; i < n; ++i) {
+            for (typename Matrix::InnerIterator it(A, i); it; ++it) {
+                if (it.col() != i && isStrong(diag, i, it.col(), it.value(), eps))
+                    strong[i].emplace_back(it.col());
+            }
+        }
+
+        Index count = 0;
+        aggregates.assign(n, undefined);
+        //pass 1, roots whose strong neighborhood is still free
+        for (Index i = 0; i < n; ++i) {
+            if (undefined != aggregates[i]) continue;
+            if (strong[i].empty()) {
+                aggregates[i] = removed;
+                continue;
+            }
+            bool free = std::all_of(strong[i].begin(), strong[i].end(), [&](auto j) { return undefined == aggregates[j]; });
+            if (not free) continue;
+            aggregates[i] = count;
+            for (auto j : strong[i]) aggregates[j] = count;
+            ++count;
+        }
+        //pass 2, attach the rest to the most strongly coupled aggregate of pass 1
+        const auto roots = aggregates;
+        for (Index i = 0; i < n; ++i) {
+            if (undefined != aggregates[i]) continue;
+            Scalar maxCoupling = 0;
+            for (typename Matrix::InnerIterator it(A, i); it; ++it) {
+                auto j = it.col();
+                if (j == i || roots[j] < 0 || std::fabs(it.value()) <= maxCoupling) continue;
+                if (std::find(strong[i].begin(), strong[i].end(), j) == strong[i].end()) continue;
+                maxCoupling = std::fabs(it.value());
+                aggregates[i] = roots[j];
+            }
+        }
+        //pass 3, leftovers form new aggregates with their free strong neighbors
+        for (Index i = 0; i < n; ++i) {
+            if (undefined != aggregates[i]) continue;
+            aggregates[i] = count;
+            for (auto j : strong[i])
+                if (undefined == aggregates[j]) aggregates[j] = count;
+            ++count;
+        }
+        return count;
+    }
+
+    ///@brief P = (I - w D_f^-1 A_f) P0, A_f keeps the strong couplings and lumps the weak ones into the diagonal,
+    ///       P0 is the piecewise constant interpolation of the aggregates, the near null space of a conductance matrix
+    Matrix SmoothedProlongation(const Matrix & A, Scalar eps, const std::vector<Index> & aggregates, Index count)
+    {
+        const Index n = A.rows();
+        const Vector diag = A.diagonal();
+        Vector filteredDiag = diag;
+        Scalar rho = 0;//Gershgorin bound of the spectral radius of D_f^-1 A_f
+        for (Index i = 0; i < n; ++i) {
+            Scalar offDiag = 0;
+            for (typename Matrix::InnerIterator it(A, i); it; ++it) {
+                if (it.col() == i) continue;
+                if (isStrong(diag, i, it.col(), it.value(), eps))
+                    offDiag += std::fabs(it.value());
+                else filteredDiag[i] += it.value();
+            }
+            if (filteredDiag[i] <= 0) filteredDiag[i] = diag[i];
+            rho = std::max(rho, 1 + offDiag / filteredDiag[i]);
+        }
+
+        const Scalar omega = settings.relax / rho;
+        std::vector<Eigen::Triplet<Scalar> > triplets;
+        triplets.reserve(A.nonZeros());
+        for (Index i = 0; i < n; ++i) {
+            const Scalar scale = omega / filteredDiag[i];
+            if (aggregates[i] >= 0)
+                triplets.emplace_back(i, aggregates[i], 1 - scale * filteredDiag[i]);
+            for (typename Matrix::InnerIterator it(A, i); it; ++it) {
+                auto j = it.col();
+                if (j == i || aggregates[j] < 0) continue;
+                if (not isStrong(diag, i, j, it.value(), eps)) continue;
+                triplets.emplace_back(i, aggregates[j], -scale * it.value());
+            }
+        }
+        Matrix P(n, count);
+        P.setFromTriplets(triplets.begin(), triplets.end());
+        return P;
+    }
+
+    ///@brief symmetric V-cycle, forward Gauss-Seidel before and backward after the coarse correction
+    template <typename Rhs>
+    void Cycle(size_t level, const Rhs & b, Vector & x) const
+    {
+        if (level + 1 == m_levels.size()) {
+            x = m_coarse.solve(Vector(b));
+            return;
+        }
+        const auto & curr = m_levels.at(level);
+        for (size_t i = 0; i < settings.sweeps; ++i)
+            GaussSeidel(curr, b, x, true);
+
+        Vector r = b - curr.A * x;
+        Vector coarseB = curr.R * r;
+        Vector coarseX = Vector::Zero(coarseB.size());
+        Cycle(level + 1, coarseB, coarseX);
+        x += curr.P * coarseX;
+
+        for (size_t i = 0; i < settings.sweeps; ++i)
+            GaussSeidel(curr, b, x, false);
+    }
+
+    template <typename Rhs>
+    static void GaussSeidel(const Level & level, const Rhs & b, Vector & x, bool forward)
+    {
+        const Index n = level.A.rows();
+        for (Index k = 0; k < n; ++k) {
+            const Index i = forward ? k : n - 1 - k;
+            Scalar sum = b[i];
+            for (typename Matrix::InnerIterator it(level.A, i); it; ++it)
+                if (it.col() != i) sum -= it.value() * x[it.col()];
+            x[i] = sum * level.invDiag[i];
+        }
+    }
+
+private:
+    std::vector<Level> m_levels;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<Scalar> > m_coarse;
+    Eigen::ComputationInfo m_info{Eigen::Success};
+};
+
+} // namespace thermal::solver
@@ -5,7 +5,10 @@
 #include "generic/tools/Format.hpp"
 #include "generic/circuit/MNA.hpp"
 #include <unordered_map>
+#include <algorithm>
+#include <numeric>
 #include <memory>
+#include <tuple>
 #include <set>
 
 namespace thermal {
@@ -17,28 +20,7 @@ class ThermalNetwork
 public:
     inline static constexpr num_type minR = std::numeric_limits<num_type>::epsilon();
     inline static constexpr num_type unknownT = std::numeric_limits<num_type>::max();
-    struct Node
-    {
-        size_t scen = std::numeric_limits<size_t>::max();
-        num_type t = unknownT;//unit: K
-        num_type c = 0;
-        num_type hf = 0;//unit: W
-        num_type htc = 0;//unit: W/k
-        std::unordered_map<size_t, num_type> ns;
-        std::string msg(size_t index) const
-        {
-            using namespace generic::fmt;
-            std::stringstream ss;
-            ss << Fmt2Str("ID: %1%, T:%2%, C:%3%, HF:%4%, HTC:%5%", index, t, c, hf, htc);
-            if (not ns.empty()) {
-                ss << ", N:[";
-                for (const auto & [id, r] : ns)
-                    ss << Fmt2Str("%1%(%2%) ", id, r);
-                ss << ']';
-            }
-            return ss.str();
-        }
-    };
+    inline static constexpr size_t noScenario = std::numeric_limits<size_t>::max();
 
     struct Edge
     {
@@ -48,131 +30,281 @@ public:
 
     explicit ThermalNetwork(size_t nodes)
     {
-        m_nodes.assign(nodes, Node{});
+        m_scen.assign(nodes, noScenario);
+        m_t.assign(nodes, unknownT);
+        m_c.assign(nodes, 0);
+        m_hf.assign(nodes, 0);
+        m_htc.assign(nodes, 0);
+        m_rowPtr.assign(nodes + 1, 0);
+        m_fill.assign(nodes, 0);
     }
 
     virtual ~ThermalNetwork() = default;
 
     size_t Size() const
     {
-        return m_nodes.size();
+        return m_t.size();
     }
 
     size_t Source(bool includeBonds) const
     {
         size_t size{0};
-        for (const auto & node : m_nodes) {
-            if (node.hf != 0 || (includeBonds && node.htc != 0))
+        for (size_t i = 0; i < Size(); ++i) {
+            if (m_hf[i] != 0 || (includeBonds && m_htc[i] != 0))
                 size++;
         }
         return size;//todo , remove
     }
 
-    Node & operator[] (size_t i) 
-    {
-        return m_nodes[i]; 
-    }
-
-    const Node & operator[] (size_t i) const
-    {
-        return m_nodes.at(i);
-    }
-    
     size_t AppendNode(num_type t = unknownT)
     {
         size_t index = Size();
-        m_nodes.push_back(Node());
-        m_nodes.back().t = t;
+        m_scen.push_back(noScenario);
+        m_t.push_back(t);
+        m_c.push_back(0);
+        m_hf.push_back(0);
+        m_htc.push_back(0);
+        m_rowPtr.push_back(m_allocated ? m_rowPtr.back() : 0);
+        m_fill.push_back(0);
         return index;
     }
 
     void SetScenario(size_t node, size_t scen)
     {
-        m_nodes[node].scen = scen;
+        m_scen[node] = scen;
+    }
+
+    size_t GetScenario(size_t node) const
+    {
+        return m_scen[node];
     }
 
     void SetT(size_t node, num_type t)
     {
-        m_nodes[node].t = t;
+        m_t[node] = t;
     }
 
     num_type GetT(size_t node) const
     {
-        return m_nodes[node].t;
+        return m_t[node];
     }
 
     void SetHF(size_t node, num_type hf)
     {
-        m_nodes[node].hf = hf;
+        m_hf[node] = hf;
     }
 
     void AddHF(size_t node, num_type hf)
     {
-        m_nodes[node].hf += hf;
+        m_hf[node] += hf;
     }
 
     num_type GetHF(size_t node) const
     {
-        return m_nodes[node].hf;
+        return m_hf[node];
     }
 
     void SetHTC(size_t node, num_type htc)
     {
-        m_nodes[node].htc = htc;
+        m_htc[node] = htc;
     }
     
     void AddHTC(size_t node, num_type htc)
     {
-        m_nodes[node].htc += htc;
+        m_htc[node] += htc;
     }
 
     num_type GetHTC(size_t node) const
     {
-        return m_nodes[node].htc;
+        return m_htc[node];
     }
 
     void SetC(size_t node, num_type c)
     {
-        m_nodes[node].c = c;
+        m_c[node] = c;
+    }
+
+    num_type GetC(size_t node) const
+    {
+        return m_c[node];
     }
 
-    void SetR(size_t node1, size_t node2, num_type r)
+    ///@brief first phase of the two-phase assembly, counts one slot for edge (node1, node2)
+    void CountR(size_t node1, size_t node2)
+    {
+        ECAD_ASSERT(not m_allocated)
+        m_rowPtr[std::min(node1, node2) + 1]++;
+    }
+
+    ///@brief ends the counting phase, allocates the adjacency slots counted by CountR()
+    void AllocateR()
+    {
+        ECAD_ASSERT(not m_allocated)
+        const size_t nodes = Size();
+        for (size_t i = 0; i < nodes; ++i)
+            m_rowPtr[i + 1] += m_rowPtr[i];
+        m_cols.assign(m_rowPtr.back(), 0);
+        m_rs.assign(m_rowPtr.back(), 0);
+        m_rSet.assign(m_rowPtr.back(), 0);
+        m_fill.assign(nodes, 0);
+        m_allocated = true;
+        m_compressed = false;
+    }
+
+    ///@brief second phase of the assembly, parallel resistances between same nodes are merged
+    ///       writes only to the row of min(node1, node2), so disjoint rows can be filled concurrently,
+    ///       edges not counted in advance are kept aside until Compress(), concurrent callers collect them
+    ///       in a pending list of their own and hand it over with AppendPendingR() after the parallel section
+    void SetR(size_t node1, size_t node2, num_type r, std::vector<Edge> * pending = nullptr)
     {
         r = std::max(r, minR);
         if (node1 > node2) std::swap(node1, node2);
-        auto & n1 = m_nodes[node1];
-        auto iter = n1.ns.find(node2);
-        if (iter != n1.ns.cend()) {
-            iter->second = 1 / (1 / r + 1 / iter->second);
+        if (m_allocated) {
+            const size_t begin = m_rowPtr[node1];
+            const size_t end = begin + m_fill[node1];
+            for (size_t k = begin; k < end; ++k) {
+                if (m_cols[k] != node2) continue;
+                m_rs[k] = m_rSet[k] ? 1 / (1 / r + 1 / m_rs[k]) : r;
+                m_rSet[k] = 1;
+                return;
+            }
+            if (end < m_rowPtr[node1 + 1]) {
+                m_cols[end] = node2;
+                m_rs[end] = r;
+                m_rSet[end] = 1;
+                m_fill[node1]++;
+                return;
+            }
+        }
+        if (pending) {
+            pending->emplace_back(Edge{node1, node2, r});
             return;
         }
-        n1.ns.emplace(node2, r);
+        m_compressed = false;
+        m_edges.emplace_back(Edge{node1, node2, r});
     }
 
-    std::vector<Node> & GetNodes()
+    ///@brief keeps edges collected by SetR() in a pending list aside until Compress()
+    void AppendPendingR(const std::vector<Edge> & edges)
     {
-        return m_nodes;
+        if (edges.empty()) return;
+        m_compressed = false;
+        m_edges.insert(m_edges.end(), edges.begin(), edges.end());
     }
-    
-    const std::vector<Node> & GetNodes() const
+
+    ///@brief merges pending edges into the adjacency and sorts each row, must be called after assembly
+    void Compress()
+    {
+        if (m_compressed) return;
+        const size_t nodes = Size();
+        std::vector<size_t> rowPtr(nodes + 1, 0);
+        for (size_t i = 0; i < nodes; ++i)
+            rowPtr[i + 1] = m_fill[i];
+        for (const auto & edge : m_edges)
+            rowPtr[edge.x + 1]++;
+        for (size_t i = 0; i < nodes; ++i)
+            rowPtr[i + 1] += rowPtr[i];
+
+        std::vector<size_t> fill(nodes, 0);
+        std::vector<size_t> cols(rowPtr.back());
+        std::vector<num_type> rs(rowPtr.back());
+        std::vector<char> rSet(rowPtr.back(), 0);
+        for (size_t i = 0; i < nodes && m_allocated; ++i) {
+            std::copy_n(m_cols.begin() + m_rowPtr[i], m_fill[i], cols.begin() + rowPtr[i]);
+            std::copy_n(m_rs.begin() + m_rowPtr[i], m_fill[i], rs.begin() + rowPtr[i]);
+            std::copy_n(m_rSet.begin() + m_rowPtr[i], m_fill[i], rSet.begin() + rowPtr[i]);
+            fill[i] = m_fill[i];
+        }
+        for (const auto & edge : m_edges) {
+            const size_t begin = rowPtr[edge.x];
+            const size_t end = begin + fill[edge.x];
+            auto iter = std::find(cols.begin() + begin, cols.begin() + end, edge.y);
+            if (iter != cols.begin() + end) {
+                auto k = std::distance(cols.begin(), iter);
+                rs[k] = rSet[k] ? 1 / (1 / edge.r + 1 / rs[k]) : edge.r;
+                rSet[k] = 1;
+            }
+            else {
+                cols[end] = edge.y;
+                rs[end] = edge.r;
+                rSet[end] = 1;
+                fill[edge.x]++;
+            }
+        }
+
+        //pack and sort rows by column
+        m_rowPtr.assign(nodes + 1, 0);
+        std::vector<std::tuple<size_t, num_type, char> > row;
+        for (size_t i = 0, k = 0; i < nodes; ++i) {
+            row.clear();
+            for (size_t j = rowPtr[i]; j < rowPtr[i] + fill[i]; ++j)
+                row.emplace_back(cols[j], rs[j], rSet[j]);
+            std::sort(row.begin(), row.end(), [](const auto & a, const auto & b){ return std::get<0>(a) < std::get<0>(b); });
+            for (const auto & [col, r, set] : row) {
+                cols[k] = col; rs[k] = r; rSet[k] = set; k++;
+            }
+            m_rowPtr[i + 1] = k;
+        }
+        cols.resize(m_rowPtr.back()); cols.shrink_to_fit();
+        rs.resize(m_rowPtr.back()); rs.shrink_to_fit();
+        rSet.resize(m_rowPtr.back()); rSet.shrink_to_fit();
+        m_cols = std::move(cols);
+        m_rs = std::move(rs);
+        m_rSet = std::move(rSet);
+        for (size_t i = 0; i < nodes; ++i)
+            m_fill[i] = m_rowPtr[i + 1] - m_rowPtr[i];
+        m_edges.clear();
+        m_edges.shrink_to_fit();
+        m_allocated = true;
+        m_compressed = true;
+    }
+
+    bool isCompressed() const
+    {
+        return m_compressed;
+    }
+
+    ///@brief clears node data and edge values of a compressed network but keeps its adjacency,
+    ///       a following assembly with the same edges merges into the existing slots through SetR() without reallocation,
+    ///       slots not set again by that assembly are skipped by ForEachR()
+    void ResetValues()
+    {
+        ECAD_ASSERT(m_compressed)
+        std::fill(m_scen.begin(), m_scen.end(), noScenario);
+        std::fill(m_t.begin(), m_t.end(), unknownT);
+        std::fill(m_c.begin(), m_c.end(), 0);
+        std::fill(m_hf.begin(), m_hf.end(), 0);
+        std::fill(m_htc.begin(), m_htc.end(), 0);
+        std::fill(m_rs.begin(), m_rs.end(), 0);
+        std::fill(m_rSet.begin(), m_rSet.end(), 0);
+    }
+
+    size_t TotalEdges() const
+    {
+        ECAD_ASSERT(m_compressed)
+        return m_rowPtr.back();
+    }
+
+    ///@brief visits edges (node, neighbor > node, r) of the compressed adjacency
+    template <typename Func>
+    void ForEachR(size_t node, Func && func) const
     {
-        return m_nodes;
+        ECAD_ASSERT(m_compressed)
+        for (size_t k = m_rowPtr[node]; k < m_rowPtr[node + 1]; ++k)
+            if (m_rSet[k]) func(m_cols[k], m_rs[k]);
     }
 
     num_type TotalHF() const
     {
-        num_type total{0};
-        for (const auto & node : m_nodes)
-            total += node.hf;
-        return total;
+        return std::accumulate(m_hf.begin(), m_hf.end(), num_type{0});
     }
 
     num_type MinT() const
     {
         num_type minT = std::numeric_limits<num_type>::max();
-        for (const auto & node : m_nodes) {
-            if (node.t == unknownT) continue;
-            minT = std::min<num_type>(minT, node.t);
+        for (auto t : m_t) {
+            if (t == unknownT) continue;
+            minT = std::min<num_type>(minT, t);
         }
         return minT;
     }
@@ -180,15 +312,43 @@ public:
     num_type MaxT() const
     {
         num_type maxT = -std::numeric_limits<num_type>::max();
-        for (const auto & node : m_nodes) {
-            if (node.t == unknownT) continue;
-            maxT = std::max<num_type>(maxT, node.t);
+        for (auto t : m_t) {
+            if (t == unknownT) continue;
+            maxT = std::max<num_type>(maxT, t);
         }
         return maxT;
     }
 
+    std::string NodeMsg(size_t index) const
+    {
+        using namespace generic::fmt;
+        std::stringstream ss;
+        ss << Fmt2Str("ID: %1%, T:%2%, C:%3%, HF:%4%, HTC:%5%", index, m_t[index], m_c[index], m_hf[index], m_htc[index]);
+        if (m_fill[index] > 0) {
+            ss << ", N:[";
+            for (size_t k = m_rowPtr[index]; k < m_rowPtr[index] + m_fill[index]; ++k)
+                if (m_rSet[k]) ss << Fmt2Str("%1%(%2%) ", m_cols[k], m_rs[k]);
+            ss << ']';
+        }
+        return ss.str();
+    }
+
 private:
-    std::vector<Node> m_nodes;
+    // node data, structure of arrays
+    std::vector<size_t> m_scen;
+    std::vector<num_type> m_t;//unit: K
+    std::vector<num_type> m_c;
+    std::vector<num_type> m_hf;//unit: W
+    std::vector<num_type> m_htc;//unit: W/k
+    // upper triangular adjacency in CSR, row i holds neighbors j > i
+    bool m_allocated{false};
+    bool m_compressed{true};
+    std::vector<size_t> m_rowPtr;
+    std::vector<size_t> m_fill;
+    std::vector<size_t> m_cols;
+    std::vector<num_type> m_rs;//unit: K/W
+    std::vector<char> m_rSet;//whether slot k holds a resistance of the current assembly, one byte per slot so rows can be filled concurrently
+    std::vector<Edge> m_edges;//pending edges not counted in advance
 };
 
 using namespace generic::ckt;
@@ -200,9 +360,9 @@ inline DenseVector<num_type> makeRhs(const ThermalNetwork<num_type> & network, b
     const size_t source = network.Source(includeBonds);
     DenseVector<num_type> rhs(source);
     for(size_t i = 0, s = 0; i < nodes; ++i) {
-        const auto & node = network[i];
-        if (node.hf != 0 || (includeBonds && node.htc != 0))
-            rhs[s++] = node.hf + node.htc * refT;
+        auto hf = network.GetHF(i), htc = network.GetHTC(i);
+        if (hf != 0 || (includeBonds && htc != 0))
+            rhs[s++] = hf + htc * refT;
     }
     return rhs;
 }
@@ -212,115 +372,171 @@ inline DenseVector<num_type> makeFullRhs(const ThermalNetwork<num_type> & networ
 {
     const size_t nodes = network.Size();
     DenseVector<num_type> rhs(nodes);
-    for(size_t i = 0 ; i < nodes; ++i) {
-        const auto & node = network[i];
-        rhs[i] = node.hf + node.htc * refT;
-    }
+    for(size_t i = 0 ; i < nodes; ++i)
+        rhs[i] = network.GetHF(i) + network.GetHTC(i) * refT;
     return rhs;
 }
 
+///@brief builds a compressed matrix with at most one entry per column, located at row rowOf(col)
+template <typename num_type, typename RowOf, typename ValueOf>
+inline SparseMatrix<num_type> makeSingleEntryColumns(size_t rows, size_t cols, size_t entries, RowOf && rowOf, ValueOf && valueOf, const std::vector<bool> & hasEntry = {})
+{
+    using Matrix = SparseMatrix<num_type>;
+    using StorageIndex = typename Matrix::StorageIndex;
+    Matrix m(rows, cols);
+    m.resizeNonZeros(entries);
+    auto outer = m.outerIndexPtr();
+    auto inner = m.innerIndexPtr();
+    auto values = m.valuePtr();
+    StorageIndex k{0};
+    for (size_t j = 0; j < cols; ++j) {
+        outer[j] = k;
+        if (not hasEntry.empty() && not hasEntry[j]) continue;
+        inner[k] = static_cast<StorageIndex>(rowOf(j));
+        values[k++] = valueOf(j);
+    }
+    outer[cols] = k;
+    ECAD_ASSERT(static_cast<size_t>(k) == entries)
+    return m;
+}
+
+///@brief builds the symmetric conductance matrix straight from the network adjacency without a triplet stage,
+///       returns false if the network has pending edges, i.e. Compress() was not called after assembly
+///@param htcScale, scales the bonds to the environment without touching the network, e.g. for htc sweeps
+template <typename num_type>
+inline bool makeConductanceMatrix(const ThermalNetwork<num_type> & network, SparseMatrix<num_type> & G, num_type sign = 1, num_type htcScale = 1)
+{
+    using Matrix = SparseMatrix<num_type>;
+    using StorageIndex = typename Matrix::StorageIndex;
+
+    if (not network.isCompressed()) {
+        ECAD_ERROR("thermal network is not compressed, call Compress() after assembly");
+        return false;
+    }
+    const size_t nodes = network.Size();
+    G = Matrix(nodes, nodes);
+    auto outer = G.outerIndexPtr();
+    std::fill(outer, outer + nodes + 1, 0);
+    std::vector<num_type> diag(nodes);
+    for (size_t i = 0; i < nodes; ++i) {
+        outer[i + 1] += 1;
+        diag[i] += sign * htcScale * network.GetHTC(i);
+        network.ForEachR(i, [&](size_t j, num_type r) {
+            outer[i + 1]++; outer[j + 1]++;
+            diag[i] += sign / r; diag[j] += sign / r;
+        });
+    }
+    for (size_t i = 0; i < nodes; ++i)
+        outer[i + 1] += outer[i];
+    G.resizeNonZeros(outer[nodes]);
+    auto inner = G.innerIndexPtr();
+    auto values = G.valuePtr();
+
+    // column j receives rows i < j while visiting row i, then its diagonal and the sorted rows k > j
+    std::vector<StorageIndex> pos(outer, outer + nodes);
+    for (size_t i = 0; i < nodes; ++i) {
+        inner[pos[i]] = static_cast<StorageIndex>(i);
+        values[pos[i]++] = diag[i];
+        network.ForEachR(i, [&](size_t j, num_type r) {
+            auto g = sign / r;
+            inner[pos[i]] = static_cast<StorageIndex>(j);
+            values[pos[i]++] = -g;
+            inner[pos[j]] = static_cast<StorageIndex>(i);
+            values[pos[j]++] = -g;
+        });
+    }
+    return true;
+}
+
+template <typename num_type>
+inline SparseMatrix<num_type> makeCapacitanceMatrix(const ThermalNetwork<num_type> & network, bool inverse)
+{
+    const size_t nodes = network.Size();
+    std::vector<bool> hasEntry(nodes, false);
+    size_t entries{0};
+    for (size_t i = 0; i < nodes; ++i) {
+        if (network.GetC(i) > 0) {
+            hasEntry[i] = true;
+            entries++;
+        }
+    }
+    return makeSingleEntryColumns<num_type>(nodes, nodes, entries, [](size_t j){ return j; },
+        [&](size_t j){ return inverse ? 1 / network.GetC(j) : network.GetC(j); }, hasEntry);
+}
+
 template <typename num_type>
 inline SparseMatrix<num_type> makeBondsRhs(const ThermalNetwork<num_type> & network, num_type refT)
 {
     using Matrix = SparseMatrix<num_type>;
-    using Triplets = std::vector<Eigen::Triplet<num_type> >;
+    using StorageIndex = typename Matrix::StorageIndex;
 
-    Triplets triplets;
     const size_t nodes = network.Size();
+    std::vector<StorageIndex> rows;
     for(size_t i = 0 ; i < nodes; ++i) {
-        const auto & node = network[i];
-        if (node.htc != 0)
-            triplets.emplace_back(i, 0, node.htc * refT);
+        if (network.GetHTC(i) != 0)
+            rows.emplace_back(i);
     }
     Matrix rhs(nodes, 1);
-    rhs.setFromTriplets(triplets.begin(), triplets.end());
+    rhs.resizeNonZeros(rows.size());
+    rhs.outerIndexPtr()[0] = 0;
+    rhs.outerIndexPtr()[1] = static_cast<StorageIndex>(rows.size());
+    for (size_t k = 0; k < rows.size(); ++k) {
+        rhs.innerIndexPtr()[k] = rows[k];
+        rhs.valuePtr()[k] = network.GetHTC(rows[k]) * refT;
+    }
     return rhs;
 }
 
 template <typename num_type>
 inline SparseMatrix<num_type> makeSourceProjMatrix(const ThermalNetwork<num_type> & network, std::unordered_map<size_t, size_t> & rhs2Nodes)
 {
-    using Matrix = SparseMatrix<num_type>;
-    using Triplets = std::vector<Eigen::Triplet<num_type> >;
-    
     rhs2Nodes.clear();
-    Triplets triplets;
+    std::vector<size_t> sources;
     const size_t nodes = network.Size();    
-    for (size_t i = 0, s = 0; i < nodes; ++i) {
-        const auto & node = network[i];
-        if (node.hf != 0) {
-            rhs2Nodes.emplace(s, i);
-            triplets.emplace_back(i, s++, 1);
+    for (size_t i = 0; i < nodes; ++i) {
+        if (network.GetHF(i) != 0) {
+            rhs2Nodes.emplace(sources.size(), i);
+            sources.emplace_back(i);
         }
     }
-    auto B = Matrix(nodes, triplets.size());
-    B.setFromTriplets(triplets.begin(), triplets.end());
-    return B;
+    return makeSingleEntryColumns<num_type>(nodes, sources.size(), sources.size(),
+        [&](size_t j){ return sources[j]; }, [](size_t){ return num_type{1}; });
 }
 
 template <typename num_type>
-inline std::pair<SparseMatrix<num_type>, SparseMatrix<num_type>> makeInvCandNegG(const ThermalNetwork<num_type> & network)
+inline bool makeInvCandNegG(const ThermalNetwork<num_type> & network, SparseMatrix<num_type> & invC, SparseMatrix<num_type> & negG)
 {
-    using Matrix = SparseMatrix<num_type>;
-    using Triplets = std::vector<Eigen::Triplet<num_type> >;
-    
-    const size_t nodes = network.Size();
-    auto invC = Matrix(nodes, nodes);
-    auto negG = Matrix(nodes, nodes);
-    Triplets tG, tC;
-    for (size_t i = 0; i < nodes; ++i) {
-        const auto & node = network[i];
-        for (const auto & [n, r] : node.ns)
-            mna::Stamp(tG, i, n, - 1 / r);
-        if (node.htc != 0) mna::Stamp(tG, i, -node.htc);
-        if (node.c > 0) mna::Stamp(tC, i, 1 / node.c);
-    }
-    negG.setFromTriplets(tG.begin(), tG.end());
-    invC.setFromTriplets(tC.begin(), tC.end());
-    return {invC, negG};
+    if (not makeConductanceMatrix(network, negG, num_type{-1})) return false;
+    invC = makeCapacitanceMatrix(network, true);
+    return true;
 }
 
 template <typename num_type>
-inline MNA<SparseMatrix<num_type> > makeMNA(const ThermalNetwork<num_type> & network, bool includeBonds, const std::vector<size_t> & probs = {})
+inline bool makeMNA(const ThermalNetwork<num_type> & network, bool includeBonds, MNA<SparseMatrix<num_type> > & m, const std::vector<size_t> & probs = {})
 {
     using Matrix = SparseMatrix<num_type>;
-    using Triplets = std::vector<Eigen::Triplet<num_type> >;
     
-    MNA<Matrix> m;
+    if (not makeConductanceMatrix(network, m.G)) return false;
     const size_t nodes = network.Size();
-    const size_t source = network.Source(includeBonds);
-    Triplets tG, tC, tB;
-    m.G = Matrix(nodes, nodes);
-    m.C = Matrix(nodes, nodes);
-    m.B = Matrix(nodes, source);
-    for (size_t i = 0, s = 0; i < nodes; ++i) {
-        const auto & node = network[i];
-        for (const auto & [n, r] : node.ns)
-            mna::Stamp(tG, i, n, 1 / r);
-        if (node.htc != 0) mna::Stamp(tG, i, node.htc);
-        if (node.c > 0) mna::Stamp(tC, i, node.c);
-        if (node.hf != 0 || (includeBonds && node.htc != 0))
-            tB.emplace_back(i, s++, 1);
-    }
-    m.G.setFromTriplets(tG.begin(), tG.end());
-    m.C.setFromTriplets(tC.begin(), tC.end());
-    m.B.setFromTriplets(tB.begin(), tB.end());
+    std::vector<size_t> sources;
+    for (size_t i = 0; i < nodes; ++i) {
+        if (network.GetHF(i) != 0 || (includeBonds && network.GetHTC(i) != 0))
+            sources.emplace_back(i);
+    }
+    m.C = makeCapacitanceMatrix(network, false);
+    m.B = makeSingleEntryColumns<num_type>(nodes, sources.size(), sources.size(),
+        [&](size_t j){ return sources[j]; }, [](size_t){ return num_type{1}; });
 
     if (probs.empty()) {
         m.L = Matrix(nodes, nodes);
         m.L.setIdentity();
     }
     else {
-        size_t j{0};
-        Triplets tL;
-        for (auto p : probs) {
-            ECAD_ASSERT(p < nodes)
-            tL.emplace_back(p, j++, 1);
-        }
-        m.L = Matrix(nodes, probs.size());
-        m.L.setFromTriplets(tL.begin(), tL.end());
+        for ([[maybe_unused]] auto p : probs) { ECAD_ASSERT(p < nodes) }
+        m.L = makeSingleEntryColumns<num_type>(nodes, probs.size(), probs.size(),
+            [&](size_t j){ return probs[j]; }, [](size_t){ return num_type{1}; });
     }
-    return m;
+    return true;
 }
 
 }//namespace model
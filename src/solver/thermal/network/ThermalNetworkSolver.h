@@ -1,5 +1,8 @@
 #pragma once
+#include "AMGPreconditioner.h"
 #include "ThermalNetwork.h"
+#include "utils/ThermalNetworkSnapshot.h"
+#include "generic/thread/ThreadPool.hpp"
 #include "generic/tools/Tools.hpp"
 #include "generic/circuit/MNA.hpp"
 #include "generic/circuit/MOR.hpp"
@@ -21,74 +24,171 @@ namespace thermal::solver {
     using namespace generic;
     using namespace generic::ckt;
     template <typename Scalar>
-    class ThermalNetworkSolver
+    class ThermalNetworkStaticSolveSession
     {
     public:
-        explicit ThermalNetworkSolver(ThermalNetwork<Scalar> & network, int solverType = 2)
-            : m_network(network), m_solverType(solverType)
+        using Matrix = Eigen::SparseMatrix<Scalar>;
+        using StorageIndex = typename Matrix::StorageIndex;
+        using DenseMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+        static constexpr Eigen::Index blockCols = 32;
+        static constexpr size_t matrixMarketMaxNodes = 10000;//text dump of the snapshot only for small networks
+        explicit ThermalNetworkStaticSolveSession(int solverType = 2)
+            : m_solverType(solverType)
         {
         }
 
-        virtual ~ThermalNetworkSolver() = default;
+        virtual ~ThermalNetworkStaticSolveSession() = default;
 
-        void Solve(Scalar refT, std::vector<Scalar> & result, std::string rptDir) const
+        ///@brief solve the network, symbolic analysis is only redone if the sparsity pattern of G changed since last call
+        ///@param result, used as initial guess of iterative solver if its size matches the network
+        ///@param rptDir, if not empty, the linear system and the initial guess are dumped to rptDir/snapshot.bin for ecad_solve_replay,
+        ///       small networks are also written in matrix market format
+        ///@return false if the network is not compressed
+        bool Solve(const ThermalNetwork<Scalar> & network, Scalar refT, std::vector<Scalar> & result, std::string rptDir = {})
         {
-            using namespace generic::math::la;
-            auto m = makeMNA(m_network, true);
-            auto rhs = makeRhs(m_network, true, refT);
+            MNA<Matrix> m;
+            if (not makeMNA(network, true, m)) return false;
+            auto rhs = makeRhs(network, true, refT);
+            if (result.size() != network.Size()) result.clear();
             if (not rptDir.empty()) {
-
-                auto dumpSpMat = [](const auto & filename, auto & mat) {
-                    std::ofstream out(filename);
-                    for (int k = 0; k < mat.outerSize(); ++k)
-                        for (typename SparseMatrix<Scalar>::InnerIterator it(mat, k); it; ++it)
-                            out << it.row() << " " << it.col() << " " << it.value() << "\n";
-                    out.close();
-                };
+                using IO = utils::ThermalNetworkSnapshotIO;
+                utils::ThermalNetworkSnapshot<Scalar> snapshot{m_solverType, refT, m.G, m.C, m.B, m.L, rhs, {}};
+                snapshot.x0 = Eigen::Map<const DenseVector<Scalar>>(result.data(), result.size());
+                auto check = [](const std::string & filename, bool written) { if (not written) ECAD_TRACE("failed to write %1%", filename); };
                 generic::fs::CreateDir(rptDir);
-                dumpSpMat(rptDir + "/G.txt", m.G);
-                dumpSpMat(rptDir + "/B.txt", m.B);
-                dumpSpMat(rptDir + "/C.txt", m.C);
-                dumpSpMat(rptDir + "/L.txt", m.L);
-                std::ofstream osRhs(rptDir + "/rhs.txt");
-                osRhs << rhs; osRhs.close();
+                check(rptDir + "/snapshot.bin", IO::Write(rptDir + "/snapshot.bin", snapshot));
+                if (network.Size() <= matrixMarketMaxNodes) {
+                    check(rptDir + "/G.mtx", IO::WriteMatrixMarket(rptDir + "/G.mtx", m.G));
+                    check(rptDir + "/B.mtx", IO::WriteMatrixMarket(rptDir + "/B.mtx", m.B));
+                    check(rptDir + "/C.mtx", IO::WriteMatrixMarket(rptDir + "/C.mtx", m.C));
+                    check(rptDir + "/L.mtx", IO::WriteMatrixMarket(rptDir + "/L.mtx", m.L));
+                    check(rptDir + "/rhs.mtx", IO::WriteMatrixMarket(rptDir + "/rhs.mtx", rhs));
+                }
             }
-            result.resize(m_network.GetNodes().size(), refT);
+            //L is identity since no probs specified
+            Prepare(m.G);
+            Solve(DenseVector<Scalar>(m.B * rhs), result);
+            return true;
+        }
+
+        ///@brief factorizes the conductance matrix of the network for later Solve(b, result) calls, returns false if the network is not compressed
+        ///@param htcScale, scales the htc of all nodes in the factorized matrix, the network itself is left unchanged
+        bool Prepare(const ThermalNetwork<Scalar> & network, Scalar htcScale = 1)
+        {
+            Matrix G;
+            if (not makeConductanceMatrix(network, G, Scalar{1}, htcScale)) return false;
+            Prepare(G);
+            return true;
+        }
+
+        ///@brief factorizes a conductance matrix assembled elsewhere, e.g. loaded from a snapshot
+        void Prepare(const Matrix & G)
+        {
+            bool samePattern = UpdatePattern(G);
+            switch (m_solverType) {
+                case 0 : Factorize(m_lu, G, samePattern); break;
+                case 1 : Factorize(m_cholesky, G, samePattern); break;
+                case 2 : Factorize(m_llt, G, samePattern); break;
+                case 3 : Factorize(m_ldlt, G, samePattern); break;
+                case 10 : {
+                    m_G = G;
+                    Factorize(m_cg, m_G, samePattern);
+                    break;
+                }
+                case 11 : {
+                    m_G = G;
+                    Factorize(m_amg, m_G, samePattern);
+                    ECAD_TRACE("amg levels: %1%", m_amg.preconditioner().Levels());
+                    break;
+                }
+                default : {
+                    ECAD_ASSERT(false)
+                    break;
+                }
+            }
+        }
+
+        ///@brief solves G x = b on the last prepared conductance matrix, b is the full node vector hf + htc * refT
+        ///@param result, used as initial guess of iterative solver if its size matches b
+        void Solve(const DenseVector<Scalar> & b, std::vector<Scalar> & result)
+        {
+            bool warmStart = result.size() == size_t(b.size());
+            if (not warmStart) result.assign(b.size(), 0);
             Eigen::Map<DenseVector<Scalar>> x(result.data(), result.size());
             switch (m_solverType) {
                 case 0 : {
-                    Eigen::SparseLU<Eigen::SparseMatrix<Scalar> > solver(m.G);
-                    x = m.L * solver.solve(m.B * rhs);
+                    x = m_lu.solve(b);
                     break;
                 }
                 case 1 : {
-                    Eigen::SimplicialCholesky<Eigen::SparseMatrix<Scalar> > solver(m.G);
-                    x = m.L * solver.solve(m.B * rhs);
+                    x = m_cholesky.solve(b);
                     break;
                 }
-                case 2: {
-#ifdef ECAD_APPLE_ACCELERATE_SUPPORT
-                    Eigen::AccelerateLLT<Eigen::SparseMatrix<Scalar> > solver(m.G);
-#else
-                    Eigen::SimplicialLLT<Eigen::SparseMatrix<Scalar> > solver(m.G);
-#endif //ECAD_APPLE_ACCELERATE_SUPPORT
-                    x = m.L * solver.solve(m.B * rhs);
+                case 2 : {
+                    x = m_llt.solve(b);
+                    break;
+                }
+                case 3 : {
+                    x = m_ldlt.solve(b);
+                    break;
+                }
+                case 10 : {
+                    IterativeSolve(m_cg, b, x, warmStart);
+                    break;
+                }
+                case 11 : {
+                    IterativeSolve(m_amg, b, x, warmStart);
+                    break;
+                }
+                default : {
+                    ECAD_ASSERT(false)
+                    break;
+                }
+            }
+        }
+
+        ///@brief solves G X = B on the last prepared conductance matrix, one column per scenario,
+        ///       simplicial factors are substituted for blockCols columns at a time in a single pass over the factor
+        ///@param threads, column blocks are solved concurrently on direct solvers
+        void Solve(const DenseMatrix & B, DenseMatrix & X, size_t threads = 1)
+        {
+            X.resize(B.rows(), B.cols());
+            switch (m_solverType) {
+                case 0 : {
+                    X = m_lu.solve(B);
+                    break;
+                }
+                case 1 : {
+                    X = m_cholesky.solve(B);
                     break;
                 }
-                case 3: {
 #ifdef ECAD_APPLE_ACCELERATE_SUPPORT
-                    Eigen::AccelerateLDLT<Eigen::SparseMatrix<Scalar>,0> solver(m.G);
+                case 2 : {
+                    X = m_llt.solve(B);
+                    break;
+                }
+                case 3 : {
+                    X = m_ldlt.solve(B);
+                    break;
+                }
 #else
-                    Eigen::SimplicialLDLT<Eigen::SparseMatrix<Scalar> > solver(m.G);
-#endif //ECAD_APPLE_ACCELERATE_SUPPORT
-                    x = m.L * solver.solve(m.B * rhs);
+                case 2 : {
+                    BlockedSolve(m_llt, B, X, threads);
                     break;
                 }
-                case 10 : {
-                    Eigen::ConjugateGradient<Eigen::SparseMatrix<Scalar>, Eigen::Lower | Eigen::Upper> solver(m.G);
-                    x = m.L * solver.solve(m.B * rhs);
-                    ECAD_TRACE("#iterations: %1%", solver.iterations());
-                    ECAD_TRACE("estimated error: %1%", solver.error());
+                case 3 : {
+                    BlockedSolve(m_ldlt, B, X, threads);
+                    break;
+                }
+#endif //ECAD_APPLE_ACCELERATE_SUPPORT
+                case 10 :
+                case 11 : {
+                    //columns are independent, each one is warm started from the solution of the previous one
+                    std::vector<Scalar> x;
+                    for (Eigen::Index c = 0; c < B.cols(); ++c) {
+                        Solve(DenseVector<Scalar>(B.col(c)), x);
+                        X.col(c) = Eigen::Map<const DenseVector<Scalar>>(x.data(), x.size());
+                    }
                     break;
                 }
                 default : {
@@ -98,6 +198,137 @@ namespace thermal::solver {
             }
         }
 
+        size_t Analyzed() const { return m_analyzed; }
+        size_t Factorized() const { return m_factorized; }
+        ///@brief iterations and estimated error of the last iterative solve
+        size_t Iterations() const { return m_iterations; }
+        Scalar Error() const { return m_error; }
+
+    private:
+        bool UpdatePattern(const Matrix & G)
+        {
+            ECAD_ASSERT(G.isCompressed())
+            auto outer = G.outerIndexPtr();
+            auto inner = G.innerIndexPtr();
+            bool same = m_rows == G.rows() && m_inner.size() == size_t(G.nonZeros()) &&
+                        std::equal(m_outer.begin(), m_outer.end(), outer) &&
+                        std::equal(m_inner.begin(), m_inner.end(), inner);
+            if (same) return true;
+            m_rows = G.rows();
+            m_outer.assign(outer, outer + G.outerSize() + 1);
+            m_inner.assign(inner, inner + G.nonZeros());
+            return false;
+        }
+
+        template <typename Decomposition>
+        void Factorize(Decomposition & solver, const Matrix & G, bool samePattern)
+        {
+            if (not samePattern || 0 == m_analyzed) {
+                solver.analyzePattern(G);
+                m_analyzed++;
+            }
+            solver.factorize(G);
+            m_factorized++;
+        }
+
+        ///@brief P^T L^-T D^-1 L^-1 P B, the rows of a column block are contiguous so every factor entry updates the whole block at once
+        template <typename Decomposition>
+        static void BlockedSolve(const Decomposition & solver, const DenseMatrix & B, DenseMatrix & X, size_t threads)
+        {
+            using Block = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+            constexpr bool unitDiag = std::is_same_v<Decomposition, Eigen::SimplicialLDLT<Matrix> >;
+            const auto & L = solver.matrixL().nestedExpression();
+            const auto n = L.cols();
+            X.resize(B.rows(), B.cols());
+            auto solveBlock = [&](Eigen::Index begin, Eigen::Index end) {
+                const bool permuted = solver.permutationP().size() > 0;
+                Block Y = B.middleCols(begin, end - begin);
+                if (permuted) Y = solver.permutationP() * Y;
+                for (Eigen::Index j = 0; j < n; ++j) {
+                    typename Matrix::InnerIterator it(L, j);
+                    if constexpr (not unitDiag) {
+                        ECAD_ASSERT(it && it.row() == j)
+                        Y.row(j) /= it.value(); ++it;
+                    }
+                    for (; it; ++it) Y.row(it.row()) -= it.value() * Y.row(j);
+                }
+                if constexpr (unitDiag) Y = solver.vectorD().asDiagonal().inverse() * Y;
+                for (Eigen::Index j = n - 1; j >= 0; --j) {
+                    typename Matrix::InnerIterator it(L, j);
+                    Scalar diag{1};
+                    if constexpr (not unitDiag) { diag = it.value(); ++it; }
+                    for (; it; ++it) Y.row(j) -= it.value() * Y.row(it.row());
+                    Y.row(j) /= diag;
+                }
+                if (permuted) X.middleCols(begin, end - begin) = solver.permutationPinv() * Y;
+                else X.middleCols(begin, end - begin) = Y;
+            };
+            const auto blocks = (B.cols() + blockCols - 1) / blockCols;
+            auto solveBlocks = [&](Eigen::Index first, Eigen::Index last) {
+                for (auto b = first; b < last; ++b)
+                    solveBlock(b * blockCols, std::min(B.cols(), (b + 1) * blockCols));
+            };
+            const auto chunks = std::min<Eigen::Index>(std::max<size_t>(1, threads), blocks);
+            if (chunks > 1) {
+                generic::thread::ThreadPool pool(chunks);
+                for (Eigen::Index c = 0; c < chunks; ++c)
+                    pool.Submit(std::bind(solveBlocks, c * blocks / chunks, (c + 1) * blocks / chunks));
+            }
+            else solveBlocks(0, blocks);
+        }
+
+        template <typename IterativeSolver, typename Vector>
+        void IterativeSolve(IterativeSolver & solver, const DenseVector<Scalar> & b, Vector & x, bool warmStart)
+        {
+            if (warmStart) x = solver.solveWithGuess(b, DenseVector<Scalar>(x));
+            else x = solver.solve(b);
+            m_iterations = solver.iterations();
+            m_error = solver.error();
+            ECAD_TRACE("#iterations: %1%", m_iterations);
+            ECAD_TRACE("estimated error: %1%", m_error);
+        }
+
+    private:
+        int m_solverType{2};
+        size_t m_analyzed{0};
+        size_t m_factorized{0};
+        size_t m_iterations{0};
+        Scalar m_error{0};
+        Eigen::Index m_rows{0};
+        std::vector<StorageIndex> m_outer;
+        std::vector<StorageIndex> m_inner;
+        Matrix m_G;//iterative solvers only keep a reference to the matrix they are prepared on
+        Eigen::SparseLU<Matrix> m_lu;
+        Eigen::SimplicialCholesky<Matrix> m_cholesky;
+#ifdef ECAD_APPLE_ACCELERATE_SUPPORT
+        Eigen::AccelerateLLT<Matrix> m_llt;
+        Eigen::AccelerateLDLT<Matrix, 0> m_ldlt;
+#else
+        Eigen::SimplicialLLT<Matrix> m_llt;
+        Eigen::SimplicialLDLT<Matrix> m_ldlt;
+#endif //ECAD_APPLE_ACCELERATE_SUPPORT
+        Eigen::ConjugateGradient<Matrix, Eigen::Lower | Eigen::Upper> m_cg;
+        Eigen::ConjugateGradient<Matrix, Eigen::Lower | Eigen::Upper, SmoothedAggregationAMG<Scalar> > m_amg;
+    };
+
+    template <typename Scalar>
+    class ThermalNetworkSolver
+    {
+    public:
+        explicit ThermalNetworkSolver(ThermalNetwork<Scalar> & network, int solverType = 2)
+            : m_network(network), m_solverType(solverType)
+        {
+        }
+
+        virtual ~ThermalNetworkSolver() = default;
+
+        bool Solve(Scalar refT, std::vector<Scalar> & result, std::string rptDir) const
+        {
+            result.clear();
+            ThermalNetworkStaticSolveSession<Scalar> session(m_solverType);
+            return session.Solve(m_network, refT, result, std::move(rptDir));
+        }
+
     private:
         ThermalNetwork<Scalar> & m_network;
         int m_solverType{2};
@@ -132,52 +363,56 @@ namespace thermal::solver {
         }
     };
 
-    template <typename Scalar>
-    class ThermalNetworkTransientSolver
+    template <typename Scalar, typename TransientSolver>
+    struct TransientSampler
     {
-    public:
         using StateType = std::vector<Scalar>;
-        struct Sampler
+        Scalar endT{0};
+        Scalar prev{0};
+        Scalar count{0};
+        bool verbose{false};
+        StateType & lastState;
+        Samples<Scalar> & samples;
+        TimeWindow<Scalar> window;
+        const TransientSolver & solver;
+        TransientSampler(const TransientSolver & solver, Samples<Scalar> & samples, StateType & lastState, TimeWindow<Scalar> window, Scalar endT, bool verbose)
+         : endT(endT), verbose(verbose), lastState(lastState), samples(samples), window(std::move(window)), solver(solver)
         {
-            Scalar endT{0};
-            Scalar prev{0};
-            Scalar count{0};
-            bool verbose{false};
-            StateType & lastState;
-            Samples<Scalar> & samples;
-            TimeWindow<Scalar> window;
-            const ThermalNetworkTransientSolver & solver;
-            Sampler(const ThermalNetworkTransientSolver & solver, Samples<Scalar> & samples, StateType & lastState, TimeWindow<Scalar> window, Scalar endT, bool verbose)
-             : endT(endT), verbose(verbose), lastState(lastState), samples(samples), window(std::move(window)), solver(solver)
-            {
-                if (not samples.empty())
-                    prev = samples.back().front();
-                samples.reserve(window.EsitimateSamples());
-            }
-            virtual ~Sampler() = default;
-            void operator() (const StateType & x, Scalar t)
-            {
-                if (window.isInside(t)) {
-                    if (count += t - prev; count > window.interval) {
-                        const auto & probs = solver.Probs();
-                        Sample<Scalar> sample; sample.reserve(probs.size() + 1);
-                        sample.emplace_back(t);
-                        for (auto p : probs) sample.emplace_back(x[p]);
-                        if (verbose) {
-                            auto res = sample;
-                            auto begin = res.begin(); begin++;
-                            std::for_each(begin, res.end(), [](auto & t){ t = generic::unit::Kelvins2Celsius(t); });
-                            ECAD_TRACE(generic::fmt::Fmt2Str(res, ","));
-                        }
-                        samples.emplace_back(std::move(sample));
-                        count = 0;
+            if (not samples.empty())
+                prev = samples.back().front();
+            samples.reserve(window.EsitimateSamples());
+        }
+        virtual ~TransientSampler() = default;
+        void operator() (const StateType & x, Scalar t)
+        {
+            if (window.isInside(t)) {
+                if (count += t - prev; count > window.interval) {
+                    const auto & probs = solver.Probs();
+                    Sample<Scalar> sample; sample.reserve(probs.size() + 1);
+                    sample.emplace_back(t);
+                    for (auto p : probs) sample.emplace_back(x[p]);
+                    if (verbose) {
+                        auto res = sample;
+                        auto begin = res.begin(); begin++;
+                        std::for_each(begin, res.end(), [](auto & t){ t = generic::unit::Kelvins2Celsius(t); });
+                        ECAD_TRACE(generic::fmt::Fmt2Str(res, ","));
                     }
-                    prev = t;
+                    samples.emplace_back(std::move(sample));
+                    count = 0;
                 }
-                if (math::GE<Scalar>(t, endT)) lastState = x;
+                prev = t;
             }
-        };
-    
+            if (math::GE<Scalar>(t, endT)) lastState = x;
+        }
+    };
+
+    template <typename Scalar>
+    class ThermalNetworkTransientSolver
+    {
+    public:
+        using StateType = std::vector<Scalar>;
+        using Sampler = TransientSampler<Scalar, ThermalNetworkTransientSolver>;
+
         struct Intermidiate
         {
             Scalar refT = 25;
@@ -191,7 +426,9 @@ namespace thermal::solver {
             Intermidiate(const ThermalNetwork<Scalar> & network, Scalar refT)
                 : refT(refT), network(network)
             {
-                auto [invC, negG] = makeInvCandNegG(network);
+                //an empty system has no state, solves report 0 steps
+                SparseMatrix<Scalar> invC, negG;
+                if (not makeInvCandNegG(network, invC, negG)) return;
                 coeff = invC * negG;
 
                 htcM = invC * makeBondsRhs(network, refT);
@@ -199,8 +436,8 @@ namespace thermal::solver {
                 scen = DenseVector<Scalar>(rhs2Nodes.size());
                 hf = DenseVector<Scalar>(rhs2Nodes.size());
                 for (auto [rhs, node] : rhs2Nodes) {
-                    scen[rhs] = network[node].scen;
-                    hf[rhs] = network[node].hf;
+                    scen[rhs] = network.GetScenario(node);
+                    hf[rhs] = network.GetHF(node);
                 }
             }
             virtual ~Intermidiate() = default;
@@ -230,14 +467,20 @@ namespace thermal::solver {
         };
         
         ThermalNetworkTransientSolver(const ThermalNetwork<Scalar> & network, Scalar refT, std::vector<size_t> probs)
-            : m_refT(refT), m_probs(std::move(probs)), m_network(network)
+            : m_refT(refT), m_probs(std::move(probs))
         {
-            m_im.reset(new Intermidiate(m_network, m_refT));
+            m_im.reset(new Intermidiate(network, m_refT));
         }
 
         virtual ~ThermalNetworkTransientSolver() = default;
         size_t StateSize() const { return m_im->StateSize(); }
 
+        ///@brief refreshes the system after the values of the network changed, e.g. temperature dependent properties
+        void Update(const ThermalNetwork<Scalar> & network)
+        {
+            m_im.reset(new Intermidiate(network, m_refT));
+        }
+
         template <typename Observer = Sampler, typename Excitation>
         size_t SolveAdaptive(StateType & initState, Scalar t0, Scalar duration, Scalar dt, Scalar absErr, Scalar relErr, Observer observer, const Excitation * e = nullptr)
         {
@@ -262,10 +505,253 @@ namespace thermal::solver {
     private:
         Scalar m_refT;
         std::vector<size_t> m_probs;
-        const ThermalNetwork<Scalar> & m_network;
         std::unique_ptr<Intermidiate> m_im{nullptr};
     };
 
+    enum class ImplicitMethod { BackwardEuler = 1, Trapezoidal = 2, BDF2 = 3 };
+
+    ///@brief A-stable integrator of C * dx/dt = -G * x + b(t), each step solves (alpha * C + G) * x = rhs
+    ///       step sizes are kept on a power of two ladder of the initial step so the factorizations can be cached and reused,
+    ///       maxFactorizations bounds the memory held by the cache,
+    ///       a solve that starts where the previous one ended continues with its accepted history and step size
+    template <typename Scalar>
+    class ThermalNetworkImplicitTransientSolver
+    {
+    public:
+        using StateType = std::vector<Scalar>;
+        using VectorType = DenseVector<Scalar>;
+        using Sampler = TransientSampler<Scalar, ThermalNetworkImplicitTransientSolver>;
+        using Factorization = Eigen::SimplicialLDLT<SparseMatrix<Scalar> >;
+        inline static constexpr int minStepLevel = -30;
+
+        struct Intermidiate
+        {
+            Scalar refT = 25;
+            VectorType hf;
+            VectorType bonds;
+            SparseMatrix<Scalar> G;
+            SparseMatrix<Scalar> C;
+            SparseMatrix<Scalar> hfP;
+            std::vector<size_t> scen;
+            std::unordered_map<size_t, size_t> rhs2Nodes;
+            Intermidiate(const ThermalNetwork<Scalar> & network, Scalar refT)
+                : refT(refT)
+            {
+                //an empty system has no state, solves report 0 steps
+                if (not makeConductanceMatrix(network, G)) return;
+                C = makeCapacitanceMatrix(network, false);
+                bonds = makeBondsRhs(network, refT).toDense();
+                hfP = makeSourceProjMatrix(network, rhs2Nodes);
+                hf = VectorType(rhs2Nodes.size());
+                scen.resize(rhs2Nodes.size());
+                for (auto [rhs, node] : rhs2Nodes) {
+                    scen[rhs] = network.GetScenario(node);
+                    hf[rhs] = network.GetHF(node);
+                }
+            }
+            virtual ~Intermidiate() = default;
+            size_t StateSize() const { return G.cols(); }
+
+            template <typename Excitation>
+            void Input(Scalar t, const Excitation * e, VectorType & b) const
+            {
+                VectorType u(hf.size());
+                for (int i = 0; i < hf.size(); ++i)
+                    u[i] = hf[i] * (e ? (*e)(t, scen[i]) : 1);
+                b = bonds + hfP * u;
+            }
+        };
+
+        ThermalNetworkImplicitTransientSolver(const ThermalNetwork<Scalar> & network, Scalar refT, std::vector<size_t> probs, ImplicitMethod method = ImplicitMethod::BDF2, size_t maxFactorizations = 16)
+            : m_refT(refT), m_method(method), m_maxFactorizations(maxFactorizations), m_probs(std::move(probs))
+        {
+            m_im.reset(new Intermidiate(network, m_refT));
+        }
+
+        virtual ~ThermalNetworkImplicitTransientSolver() = default;
+        size_t StateSize() const { return m_im->StateSize(); }
+
+        ///@brief refreshes the system after the values of the network changed, e.g. temperature dependent properties,
+        ///       cached factorizations keep their symbolic analysis if the sparsity pattern is unchanged and are refactorized on next use
+        void Update(const ThermalNetwork<Scalar> & network)
+        {
+            std::unique_ptr<Intermidiate> im(new Intermidiate(network, m_refT));
+            bool samePattern = SamePattern(im->G, m_im->G) && SamePattern(im->C, m_im->C);
+            m_im = std::move(im);
+            if (not samePattern) {
+                m_factorizations.clear();
+                m_history.clear();
+            }
+            for (auto & factorization : m_factorizations)
+                factorization.stale = true;
+        }
+
+        ///@brief adaptive steps controlled by the local truncation error estimated from a polynomial predictor
+        template <typename Observer = Sampler, typename Excitation>
+        size_t SolveAdaptive(StateType & initState, Scalar t0, Scalar duration, Scalar dt, Scalar absErr, Scalar relErr, Observer observer, const Excitation * e = nullptr)
+        {
+            return Integrate(initState, t0, duration, dt, absErr, relErr, true, std::move(observer), e);
+        }
+
+        template <typename Observer = Sampler, typename Excitation>
+        size_t Solve(StateType & initState, Scalar t0, Scalar duration, Scalar dt, Scalar absErr, Scalar relErr, Observer observer, const Excitation * e = nullptr)
+        {
+            return Integrate(initState, t0, duration, dt, absErr, relErr, false, std::move(observer), e);
+        }
+
+        const std::vector<size_t> Probs() const { return m_probs; }
+        const Intermidiate & Im() const { return *m_im; }
+        size_t Factorized() const { return m_factorized; }
+
+    private:
+        template <typename Observer, typename Excitation>
+        size_t Integrate(StateType & initState, Scalar t0, Scalar duration, Scalar dt, Scalar absErr, Scalar relErr, bool adaptive, Observer observer, const Excitation * e)
+        {
+            if (initState.size() != StateSize()) return 0;
+            if (not (duration > 0)) return 0;
+            if (not (dt > 0)) {
+                ECAD_ERROR("implicit transient step must be positive, got %1%", dt);
+                return 0;
+            }
+
+            const auto & im = *m_im;
+            const Scalar tEnd = t0 + duration;
+            Eigen::Map<VectorType> x(initState.data(), initState.size());
+            VectorType bPrev, bNext, rhs, xNext, xPrev, xPred;
+            im.Input(t0, e, bPrev);
+
+            //accepted (t, x), latest first, used by BDF2 and the error predictor
+            auto & history = m_history;
+            auto & level = m_level;
+            if (history.empty() || not math::EQ<Scalar>(history.front().first, t0) || history.front().second != x) {
+                history.clear();
+                history.emplace_front(t0, x);
+                level = 0;
+            }
+            observer(initState, t0);
+
+            size_t steps{0};
+            Scalar hPrev{0};//x(t - h) is interpolated from the history on the first step
+            double t{t0};//accumulated in double so the last step lands on the ladder
+            while (t < tEnd) {
+                Scalar h = std::ldexp(dt, level);
+                double remain = tEnd - t;
+                bool last = remain <= h * (1 + 1e-6);
+                if (last && remain < h * (1 - 1e-6)) h = remain;
+
+                im.Input(Scalar(t + h), e, bNext);
+                size_t order{1};
+                Scalar alpha{0}, errConst{0};
+                if (ImplicitMethod::Trapezoidal == m_method) {
+                    order = 2; errConst = Scalar(1) / 13;
+                    alpha = 2 / h;
+                    rhs = im.C * (alpha * x) - im.G * x + bPrev + bNext;
+                }
+                else if (ImplicitMethod::BDF2 == m_method && history.size() > 1) {
+                    //fixed leading coefficient form, x(t - h) is interpolated if step changed, so alpha only depends on h
+                    order = 2; errConst = Scalar(2) / 11;
+                    alpha = Scalar(1.5) / h;
+                    if (h != hPrev) Predict(history, std::min<size_t>(history.size() - 1, 2), Scalar(t - h), xPrev);
+                    rhs = im.C * (alpha * (Scalar(4) / 3 * x - Scalar(1) / 3 * xPrev)) + bNext;
+                }
+                else {
+                    errConst = Scalar(1) / 3;
+                    alpha = 1 / h;
+                    rhs = im.C * (alpha * x) + bNext;
+                }
+                xNext = Factorize(alpha).solve(rhs);
+
+                if (adaptive && history.size() > order) {
+                    Predict(history, order, Scalar(t + h), xPred);
+                    Scalar err{0};
+                    for (int i = 0; i < xNext.size(); ++i)
+                        err = std::max<Scalar>(err, errConst * std::fabs(xNext[i] - xPred[i]) / (absErr + relErr * std::fabs(xNext[i])));
+                    Scalar factor = err > 0 ? Scalar(0.9) * std::pow(err, Scalar(-1) / (order + 1)) : Scalar(2);
+                    if (err > 1 && level > minStepLevel) {
+                        level = std::max(minStepLevel, level + std::min(-1, static_cast<int>(std::floor(std::log2(std::max<Scalar>(factor, 0.2))))));
+                        continue;
+                    }
+                    if (factor >= 2 && not last && std::ldexp(dt, level + 1) < duration) level++;
+                }
+
+                xPrev = x;
+                x = xNext;
+                hPrev = h;
+                t = last ? double(tEnd) : t + h;
+                bPrev = bNext;
+                history.emplace_front(Scalar(t), x);
+                if (history.size() > 3) history.pop_back();
+                observer(initState, Scalar(t));
+                steps++;
+            }
+            return steps;
+        }
+
+        ///@brief Lagrange extrapolation through the latest order + 1 accepted states
+        static void Predict(const std::list<std::pair<Scalar, VectorType> > & history, size_t order, Scalar t, VectorType & xPred)
+        {
+            auto begin = history.cbegin();
+            auto end = std::next(begin, order + 1);
+            xPred = VectorType::Zero(begin->second.size());
+            for (auto k = begin; k != end; ++k) {
+                Scalar w{1};
+                for (auto m = begin; m != end; ++m) {
+                    if (m == k) continue;
+                    w *= (t - m->first) / (k->first - m->first);
+                }
+                xPred += w * k->second;
+            }
+        }
+
+        const Factorization & Factorize(Scalar alpha)
+        {
+            auto iter = std::find_if(m_factorizations.begin(), m_factorizations.end(), [alpha](const auto & f){ return f.alpha == alpha; });
+            if (iter != m_factorizations.end()) {
+                m_factorizations.splice(m_factorizations.begin(), m_factorizations, iter);
+                auto & cached = m_factorizations.front();
+                if (cached.stale) {
+                    cached.solver->factorize(SparseMatrix<Scalar>(alpha * m_im->C + m_im->G));
+                    ECAD_ASSERT(cached.solver->info() == Eigen::Success)
+                    cached.stale = false;
+                    m_factorized++;
+                }
+                return *cached.solver;
+            }
+            if (m_factorizations.size() >= std::max<size_t>(1, m_maxFactorizations))
+                m_factorizations.pop_back();
+            SparseMatrix<Scalar> m = alpha * m_im->C + m_im->G;
+            auto solver = std::make_unique<Factorization>(m);
+            ECAD_ASSERT(solver->info() == Eigen::Success)
+            m_factorizations.emplace_front(CachedFactorization{alpha, false, std::move(solver)});
+            m_factorized++;
+            return *m_factorizations.front().solver;
+        }
+
+        static bool SamePattern(const SparseMatrix<Scalar> & a, const SparseMatrix<Scalar> & b)
+        {
+            return a.rows() == b.rows() && a.cols() == b.cols() && a.nonZeros() == b.nonZeros() &&
+                   std::equal(a.outerIndexPtr(), a.outerIndexPtr() + a.outerSize() + 1, b.outerIndexPtr()) &&
+                   std::equal(a.innerIndexPtr(), a.innerIndexPtr() + a.nonZeros(), b.innerIndexPtr());
+        }
+
+    private:
+        struct CachedFactorization
+        {
+            Scalar alpha;
+            bool stale;//values changed since the factorization, the symbolic analysis is still valid
+            std::unique_ptr<Factorization> solver;
+        };
+        Scalar m_refT;
+        ImplicitMethod m_method;
+        size_t m_maxFactorizations;
+        size_t m_factorized{0};
+        int m_level{0};
+        std::vector<size_t> m_probs;
+        std::unique_ptr<Intermidiate> m_im{nullptr};
+        std::list<std::pair<Scalar, VectorType> > m_history;
+        std::list<CachedFactorization> m_factorizations;//most recently used first
+    };
+
     template <typename Scalar>
     class ThermalNetworkReducedTransientSolver
     {
@@ -296,7 +782,9 @@ namespace thermal::solver {
                     }
                 }
                 if (not loadFromFile) {
-                    auto m = makeMNA(network, includeBonds, probs);
+                    //an empty system has no state, solves report 0 steps
+                    MNA<SparseMatrix<Scalar> > m;
+                    if (not makeMNA(network, includeBonds, m, probs)) return;
                     {
                         tools::ProgressTimer t("reduce");
                         const size_t source = network.Source(includeBonds);
@@ -402,10 +890,11 @@ namespace thermal::solver {
             {
                 const size_t nodes = im.network.Size();
                 for (size_t i = 0, s = 0; i < nodes; ++i) {
-                    const auto & node = im.network[i];
-                    Scalar excitation = e ? (*e)(t, node.scen) : 1;
-                    if (node.hf != 0 || (im.includeBonds && node.htc != 0))
-                        im.uh[s++] = node.hf * excitation + node.htc * im.refT;
+                    auto hf = im.network.GetHF(i), htc = im.network.GetHTC(i);
+                    if (hf != 0 || (im.includeBonds && htc != 0)) {
+                        Scalar excitation = e ? (*e)(t, im.network.GetScenario(i)) : 1;
+                        im.uh[s++] = hf * excitation + htc * im.refT;
+                    }
                 }
                 Eigen::Map<DenseVector<Scalar>> result(dxdt.data(), dxdt.size());
                 Eigen::Map<const DenseVector<Scalar>> xvec(x.data(), x.size());
@@ -30,6 +30,7 @@ int main(int argc, char * argv[])
     network.SetC(0, 1);
     network.SetC(1, 1);
     network.SetC(2, 1);
+    network.Compress();
 
     utils::ThermalNetlistWriter<float_t> writer(network);
     writer.WriteSpiceNetlist(std::filesystem::path(__FILE__).parent_path().string() + "/test.sp");
@@ -39,9 +40,8 @@ int main(int argc, char * argv[])
     solver::ThermalNetworkSolver<float_t> staticSolver(network, 1);
     staticSolver.Solve(refT);
 
-    const auto & nodes = network.GetNodes();
-    for(size_t i = 0; i < nodes.size(); ++i) {
-        std::cout << "node " << i + 1 <<": " << nodes[i].t << std::endl;
+    for(size_t i = 0; i < network.Size(); ++i) {
+        std::cout << "node " << i + 1 <<": " << network.GetT(i) << std::endl;
     }
 
     std::set<size_t> probs{0};
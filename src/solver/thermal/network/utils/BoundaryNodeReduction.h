@@ -21,9 +21,9 @@ public:
         std::unordered_map<size_t, size_t> nodeMap;
         num_type range = (maxT - minT) / discretization;
         for (size_t i = 0; i < nodes; ++i) {
-            auto & node = m_network[i];
-            if (node.t < minT || maxT < node.t) continue;
-            auto id = static_cast<size_t>((node.t - minT) / range);
+            auto t = m_network.GetT(i);
+            if (t < minT || maxT < t) continue;
+            auto id = static_cast<size_t>((t - minT) / range);
             auto iter = nodeMap.find(id);
             if (iter == nodeMap.cend()) {
                 auto nid = m_network.AppendNode();
@@ -31,9 +31,10 @@ public:
             }
             m_network.SetC(iter->second, FAKE_CAP);
             m_network.SetR(iter->second, i, FAKE_RES);
-            m_network.AddHTC(iter->second, node.htc);
+            m_network.AddHTC(iter->second, m_network.GetHTC(i));
             m_network.SetHTC(i, 0);
         }
+        m_network.Compress();
     }
 
 private:
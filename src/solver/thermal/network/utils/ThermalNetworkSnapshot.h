@@ -0,0 +1,205 @@
+#pragma once
+#include "solver/thermal/network/ThermalNetwork.h"
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <cstring>
+namespace thermal::utils {
+
+///@brief the linear system of one static solve, G x = B rhs, with the capacitance and output selection of the same network
+template <typename Scalar>
+struct ThermalNetworkSnapshot
+{
+    using Matrix = Eigen::SparseMatrix<Scalar>;
+    using Vector = generic::ckt::DenseVector<Scalar>;
+    int solverType{2};
+    Scalar refT{25};
+    Matrix G, C, B, L;
+    Vector rhs;
+    Vector x0;//initial guess of the iterative solvers, empty if the solve started from zero
+};
+
+///@brief binary snapshot layout, all values in native byte order:
+///       header | G | C | B | L | rhs | x0
+///       header: magic[8] "ECADSNAP", uint32 version, uint32 sizeof(Scalar), int32 solverType, Scalar refT
+///       matrix: int64 rows, int64 cols, int64 nnz, int64 rowPtr[rows + 1], int32 colIdx[nnz], Scalar values[nnz]  (CSR)
+///       vector: int64 size, Scalar values[size]
+class ThermalNetworkSnapshotIO
+{
+public:
+    static constexpr char magic[8] = {'E', 'C', 'A', 'D', 'S', 'N', 'A', 'P'};
+    static constexpr uint32_t version = 2;
+
+    ///@brief scalar size in bytes of the snapshot file, 0 if it is not a snapshot
+    static uint32_t ScalarSize(std::string_view filename)
+    {
+        std::ifstream in(std::string(filename), std::ios::binary);
+        char head[sizeof(magic)]{};
+        uint32_t ver{0}, bytes{0};
+        if (not in.read(head, sizeof(head))) return 0;
+        if (std::memcmp(head, magic, sizeof(magic)) || not Read(in, ver) || ver != version || not Read(in, bytes)) return 0;
+        return bytes;
+    }
+
+    template <typename Scalar>
+    static bool Write(std::string_view filename, const ThermalNetworkSnapshot<Scalar> & snapshot)
+    {
+        namespace sf = std::filesystem;
+        std::error_code ec;//a failure shows up as an unopened stream below
+        if (auto dir = sf::path(filename).parent_path(); not dir.empty()) sf::create_directories(dir, ec);
+        std::ofstream out(std::string(filename), std::ios::binary);
+        if (not out.is_open()) return false;
+
+        out.write(magic, sizeof(magic));
+        Write(out, version);
+        Write(out, static_cast<uint32_t>(sizeof(Scalar)));
+        Write(out, static_cast<int32_t>(snapshot.solverType));
+        Write(out, snapshot.refT);
+        for (const auto * mat : {&snapshot.G, &snapshot.C, &snapshot.B, &snapshot.L})
+            WriteMatrix(out, *mat);
+        WriteVector(out, snapshot.rhs);
+        WriteVector(out, snapshot.x0);
+        return out.good();
+    }
+
+    template <typename Scalar>
+    static bool Read(std::string_view filename, ThermalNetworkSnapshot<Scalar> & snapshot)
+    {
+        if (ScalarSize(filename) != sizeof(Scalar)) return false;
+        std::ifstream in(std::string(filename), std::ios::binary);
+        in.seekg(sizeof(magic) + 2 * sizeof(uint32_t));
+        int32_t solverType{0};
+        if (not Read(in, solverType) || not Read(in, snapshot.refT)) return false;
+        snapshot.solverType = solverType;
+        for (auto * mat : {&snapshot.G, &snapshot.C, &snapshot.B, &snapshot.L})
+            if (not ReadMatrix(in, *mat)) return false;
+        if (not ReadVector(in, snapshot.rhs)) return false;
+        return ReadVector(in, snapshot.x0);
+    }
+
+    ///@brief matrix market coordinate format, meant for small systems that are inspected by hand or loaded in other tools
+    template <typename Scalar>
+    static bool WriteMatrixMarket(std::string_view filename, const Eigen::SparseMatrix<Scalar> & mat)
+    {
+        std::ofstream out{std::string(filename)};
+        if (not out.is_open()) return false;
+        out << "%%MatrixMarket matrix coordinate real general\n";
+        out << mat.rows() << ' ' << mat.cols() << ' ' << mat.nonZeros() << '\n';
+        out << std::setprecision(std::numeric_limits<Scalar>::max_digits10);
+        for (Eigen::Index k = 0; k < mat.outerSize(); ++k)
+            for (typename Eigen::SparseMatrix<Scalar>::InnerIterator it(mat, k); it; ++it)
+                out << it.row() + 1 << ' ' << it.col() + 1 << ' ' << it.value() << '\n';
+        return out.good();
+    }
+
+    ///@brief matrix market array format of a column vector
+    template <typename Scalar>
+    static bool WriteMatrixMarket(std::string_view filename, const generic::ckt::DenseVector<Scalar> & vec)
+    {
+        std::ofstream out{std::string(filename)};
+        if (not out.is_open()) return false;
+        out << "%%MatrixMarket matrix array real general\n";
+        out << vec.size() << " 1\n";
+        out << std::setprecision(std::numeric_limits<Scalar>::max_digits10);
+        for (Eigen::Index i = 0; i < vec.size(); ++i)
+            out << vec[i] << '\n';
+        return out.good();
+    }
+
+private:
+    template <typename T>
+    static void Write(std::ofstream & out, const T & value)
+    {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    static void WriteArray(std::ofstream & out, const T * data, size_t size)
+    {
+        out.write(reinterpret_cast<const char *>(data), sizeof(T) * size);
+    }
+
+    template <typename T>
+    static bool Read(std::ifstream & in, T & value)
+    {
+        return bool(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+
+    ///@brief bytes left in the stream, sizes read from the file are checked against it before anything is allocated
+    static uint64_t Remaining(std::ifstream & in)
+    {
+        auto pos = in.tellg();
+        if (pos < 0) return 0;
+        in.seekg(0, std::ios::end);
+        auto end = in.tellg();
+        in.seekg(pos);
+        return end > pos ? static_cast<uint64_t>(end - pos) : 0;
+    }
+
+    template <typename T>
+    static bool ReadArray(std::ifstream & in, T * data, size_t size)
+    {
+        return bool(in.read(reinterpret_cast<char *>(data), sizeof(T) * size));
+    }
+
+    template <typename Scalar>
+    static void WriteVector(std::ofstream & out, const generic::ckt::DenseVector<Scalar> & vec)
+    {
+        Write(out, static_cast<int64_t>(vec.size()));
+        WriteArray(out, vec.data(), vec.size());
+    }
+
+    template <typename Scalar>
+    static bool ReadVector(std::ifstream & in, generic::ckt::DenseVector<Scalar> & vec)
+    {
+        int64_t size{0};
+        if (not Read(in, size) || size < 0) return false;
+        if (static_cast<uint64_t>(size) > Remaining(in) / sizeof(Scalar)) return false;
+        vec.resize(size);
+        return ReadArray(in, vec.data(), size);
+    }
+
+    template <typename Scalar>
+    static void WriteMatrix(std::ofstream & out, const Eigen::SparseMatrix<Scalar> & mat)
+    {
+        Eigen::SparseMatrix<Scalar, Eigen::RowMajor, int32_t> csr(mat);
+        csr.makeCompressed();
+        Write(out, static_cast<int64_t>(csr.rows()));
+        Write(out, static_cast<int64_t>(csr.cols()));
+        Write(out, static_cast<int64_t>(csr.nonZeros()));
+        std::vector<int64_t> rowPtr(csr.outerIndexPtr(), csr.outerIndexPtr() + csr.outerSize() + 1);
+        WriteArray(out, rowPtr.data(), rowPtr.size());
+        WriteArray(out, csr.innerIndexPtr(), csr.nonZeros());
+        WriteArray(out, csr.valuePtr(), csr.nonZeros());
+    }
+
+    template <typename Scalar>
+    static bool ReadMatrix(std::ifstream & in, Eigen::SparseMatrix<Scalar> & mat)
+    {
+        int64_t rows{0}, cols{0}, nnz{0};
+        if (not Read(in, rows) || not Read(in, cols) || not Read(in, nnz)) return false;
+        //the csr is read with int32 indices
+        constexpr int64_t maxIndex = std::numeric_limits<int32_t>::max();
+        if (rows < 0 || cols < 0 || nnz < 0 || rows > maxIndex || cols > maxIndex || nnz > maxIndex) return false;
+        if (static_cast<uint64_t>(rows + 1) > Remaining(in) / sizeof(int64_t)) return false;
+        std::vector<int64_t> rowPtr(rows + 1);
+        if (not ReadArray(in, rowPtr.data(), rowPtr.size())) return false;
+        if (rowPtr.front() != 0 || rowPtr.back() != nnz) return false;
+        for (int64_t r = 0; r < rows; ++r)
+            if (rowPtr[r] > rowPtr[r + 1] || rowPtr[r + 1] > maxIndex) return false;
+        if (static_cast<uint64_t>(nnz) > Remaining(in) / (sizeof(int32_t) + sizeof(Scalar))) return false;
+
+        Eigen::SparseMatrix<Scalar, Eigen::RowMajor, int32_t> csr(rows, cols);
+        csr.resizeNonZeros(nnz);
+        std::copy(rowPtr.begin(), rowPtr.end(), csr.outerIndexPtr());
+        if (not ReadArray(in, csr.innerIndexPtr(), nnz) || not ReadArray(in, csr.valuePtr(), nnz)) return false;
+        for (int64_t i = 0; i < nnz; ++i)
+            if (csr.innerIndexPtr()[i] < 0 || csr.innerIndexPtr()[i] >= cols) return false;
+        mat = csr;
+        mat.makeCompressed();
+        return true;
+    }
+};
+
+} // namespace thermal::utils
@@ -13,8 +13,9 @@ ECAD_INLINE EGridThermalNetworkBuilder<Scalar>::EGridThermalNetworkBuilder(const
 }
 
 template <typename Scalar>
-ECAD_INLINE UPtr<typename EGridThermalNetworkBuilder<Scalar>::Network> EGridThermalNetworkBuilder<Scalar>::Build(const std::vector<Scalar> & iniT) const
+ECAD_INLINE UPtr<typename EGridThermalNetworkBuilder<Scalar>::Network> EGridThermalNetworkBuilder<Scalar>::Build(const std::vector<Scalar> & iniT, size_t threads) const
 {
+    ECAD_UNUSED(threads)
     const size_t size = m_model.TotalGrids(); 
     if (iniT.size() != size) return nullptr;
 
@@ -22,12 +23,52 @@ ECAD_INLINE UPtr<typename EGridThermalNetworkBuilder<Scalar>::Network> EGridTher
     summary.totalNodes = size;
     auto network = std::make_unique<Network>(size);
 
+    //count
+    for(size_t index1 = 0; index1 < size; ++index1) {
+        auto grid1 = GetGridIndex(index1);
+        for (auto o : {Orientation::Right, Orientation::End, Orientation::Bot}) {
+            if (auto grid2 = GetNeighbor(grid1, o); isValid(grid2))
+                network->CountR(index1, GetFlattenIndex(grid2));
+        }
+    }
+    for (const auto & jc : m_model.GetJumpConnections()) {
+        auto index1 = GetFlattenIndex(std::get<0>(jc));
+        auto index2 = GetFlattenIndex(std::get<1>(jc));
+        if (index1 != index2) network->CountR(index1, index2);
+    }
+    network->AllocateR();
+    Assemble(iniT, *network);
+    network->Compress();
+    return network;
+}
+
+template <typename Scalar>
+ECAD_INLINE bool EGridThermalNetworkBuilder<Scalar>::Update(const std::vector<Scalar> & iniT, Network & network, size_t threads) const
+{
+    ECAD_UNUSED(threads)
+    const size_t size = m_model.TotalGrids();
+    if (iniT.size() != size || network.Size() < size || not network.isCompressed()) return false;
+
+    summary.Reset();
+    summary.totalNodes = size;
+    network.ResetValues();
+    auto nodes = Assemble(iniT, network);
+    //the block power nodes must match and no edge may be missing from the adjacency
+    if (network.isCompressed() && network.Size() == nodes) return true;
+    network.Compress();
+    return false;
+}
+
+template <typename Scalar>
+ECAD_INLINE size_t EGridThermalNetworkBuilder<Scalar>::Assemble(const std::vector<Scalar> & iniT, Network & network) const
+{
+    const size_t size = m_model.TotalGrids();
     //r, c
     for(size_t index1 = 0; index1 < size; ++index1) {
         auto grid1 = GetGridIndex(index1);
 
         auto c = GetCompositeMatC(grid1, GetZGridLength(grid1.z), GetZGridArea(), iniT.at(index1));
-        network->SetC(index1, c);
+        network.SetC(index1, c);
 
         auto k1 = GetCompositeMatK(grid1, iniT.at(index1));
         
@@ -40,7 +81,7 @@ ECAD_INLINE UPtr<typename EGridThermalNetworkBuilder<Scalar>::Network> EGridTher
             // auto kx = 0.5 * k1[0] + 0.5 * k2[0];
             // auto r = kx * GetXGridArea(grid1.z) / GetXGridLength();
             auto r = GetRes(k1[0], 0.5 * GetXGridLength(), k2[0], GetXGridLength(), GetXGridArea(grid1.z));
-            network->SetR(index1, index2, r);
+            network.SetR(index1, index2, r);
         }
         //back
         grid2 = GetNeighbor(grid1, Orientation::End);
@@ -50,7 +91,7 @@ ECAD_INLINE UPtr<typename EGridThermalNetworkBuilder<Scalar>::Network> EGridTher
             // auto ky = 0.5 * k1[1] + 0.5 * k2[1];
             // auto r = ky * GetYGridArea(grid1.z) / GetYGridLength();
             auto r = GetRes(k1[1], 0.5 * GetYGridLength(), k2[1], 0.5 * GetYGridLength(), GetYGridArea(grid1.z));
-            network->SetR(index1, index2, r);
+            network.SetR(index1, index2, r);
         }
         //bot
         grid2 = GetNeighbor(grid1, Orientation::Bot);
@@ -63,7 +104,7 @@ ECAD_INLINE UPtr<typename EGridThermalNetworkBuilder<Scalar>::Network> EGridTher
             // auto kz = (a1 * k1[2] + a2 * k2[2]) / (a1 + a2);
             // auto r = kz * GetZGridArea() / (0.5 * z1 + 0.5 * z2);
             auto r = GetRes(k1[2], 0.5 * GetZGridLength(grid1.z), k2[2], 0.5 * GetZGridLength(grid2.z), GetZGridArea());
-            network->SetR(index1, index2, r);
+            network.SetR(index1, index2, r);
         }
     }
     
@@ -73,27 +114,30 @@ ECAD_INLINE UPtr<typename EGridThermalNetworkBuilder<Scalar>::Network> EGridTher
         auto index2 = GetFlattenIndex(std::get<1>(jc));
         if (index1 == index2) continue;
         auto k = GetConductingMatK(std::get<0>(jc), iniT.at(index1))[0];
-        network->SetR(index1, index2, k * std::get<2>(jc));
+        network.SetR(index1, index2, k * std::get<2>(jc));
     }
 
     //power
+    size_t blockNode = size;
     const auto & layers = m_model.GetLayers();
     for(size_t z = 0; z < layers.size(); ++z) {
         const auto & layer = layers.at(z);
         auto pwrModels = layer.GetPowerModels();
         for (const auto & pwrModel : pwrModels) {
             if (auto model = dynamic_cast<CPtr<EGridPowerModel>>(pwrModel.get()); model)
-                ApplyHeatFlowForLayer(iniT, model->GetTable(), z, *network);
+                ApplyHeatFlowForLayer(iniT, model->GetTable(), z, network);
             else if (auto model = dynamic_cast<CPtr<EBlockPowerModel>>(pwrModel.get()); model) {
-                auto node = network->AppendNode();
-                network->SetHF(node, model->totalPower);
+                //block power nodes follow the grid nodes in model order, an update finds them in place
+                auto node = blockNode++;
+                if (node == network.Size()) network.AppendNode();
+                network.SetHF(node, model->totalPower);
                 if(model->totalPower > 0)
                     summary.iHeatFlow += model->totalPower;
                 else summary.oHeatFlow += model->totalPower;
                 for (size_t x = model->ll.x; x <= model->ur.x; ++x) {
                     for (size_t y = model->ll.y; y <= model->ur.y; ++y) {
                         auto index = GetFlattenIndex(ESize3D(x, y, z));
-                        network->SetR(index, node, THERMAL_RD);
+                        network.SetR(index, node, THERMAL_RD);
                     }
                 }
             }
@@ -102,16 +146,15 @@ ECAD_INLINE UPtr<typename EGridThermalNetworkBuilder<Scalar>::Network> EGridTher
 
     //bc
     if (auto topBC = m_model.GetUniformBC(EOrientation::Top); topBC && topBC->isValid())
-        ApplyUniformBoundaryConditionForLayer(*topBC, 0, *network);
+        ApplyUniformBoundaryConditionForLayer(*topBC, 0, network);
     if (auto botBC = m_model.GetUniformBC(EOrientation::Bot); botBC && botBC->isValid())
-        ApplyUniformBoundaryConditionForLayer(*botBC, m_size.z - 1, *network);
+        ApplyUniformBoundaryConditionForLayer(*botBC, m_size.z - 1, network);
 
     for (const auto & block : m_model.GetBlockBC(EOrientation::Top))
-        ApplyBlockBoundaryConditionForLayer(block.second, 0, block.first[0], block.first[1], *network);
+        ApplyBlockBoundaryConditionForLayer(block.second, 0, block.first[0], block.first[1], network);
     for (const auto & block : m_model.GetBlockBC(EOrientation::Bot))
-        ApplyBlockBoundaryConditionForLayer(block.second, m_size.z - 1, block.first[0], block.first[1], *network);
-    
-    return network;
+        ApplyBlockBoundaryConditionForLayer(block.second, m_size.z - 1, block.first[0], block.first[1], network);
+    return blockNode;
 }
 
 template <typename Scalar>
@@ -18,9 +18,14 @@ public:
     explicit EGridThermalNetworkBuilder(const ModelType & model);
     virtual ~EGridThermalNetworkBuilder() = default;
 
-    UPtr<Network> Build(const std::vector<Scalar> & iniT) const;
+    UPtr<Network> Build(const std::vector<Scalar> & iniT, size_t threads = 1) const;
+    ///@brief reassembles a network from a previous Build() of this builder in place for new temperatures,
+    ///       the adjacency and node order are kept, returns false if the network does not match the model
+    bool Update(const std::vector<Scalar> & iniT, Network & network, size_t threads = 1) const;
 
 private:
+    ///@brief returns the total nodes including the block power nodes appended after the grids
+    size_t Assemble(const std::vector<Scalar> & iniT, Network & network) const;
     void ApplyHeatFlowForLayer(const std::vector<Scalar> & iniT, const EGridDataTable & dataTable, size_t layer, Network & network) const;
     void ApplyUniformBoundaryConditionForLayer(const EThermalBoundaryCondition & bc, size_t layer, Network & network) const;
     void ApplyBlockBoundaryConditionForLayer(const EThermalBoundaryCondition & bc, size_t layer, const ESize2D & ll, const ESize2D & ur, Network & network) const;
@@ -0,0 +1,74 @@
+#include "EMaterialTable.h"
+#include "interface/IMaterialDefCollection.h"
+#include "interface/IMaterialDef.h"
+namespace ecad::solver {
+
+ECAD_INLINE EMaterialTable::EMaterialTable(CPtr<IMaterialDefCollection> matLib, const Requirements & required)
+{
+    const std::array<EMaterialPropId, properties> propIds{EMaterialPropId::ThermalConductivity, EMaterialPropId::MassDensity,
+                                                          EMaterialPropId::SpecificHeat, EMaterialPropId::Resistivity};
+    if (nullptr != matLib) {
+        auto iter = matLib->GetMaterialDefIter();
+        while (auto material = iter->Next()) {
+            auto matId = material->GetMaterialId();
+            if (matId < 0) continue;
+            for (size_t p = 0; p < properties; ++p) {
+                if (material->hasProperty(propIds[p]))
+                    Compile(matId, static_cast<Property>(p), material->GetProperty(propIds[p]));
+            }
+        }
+    }
+
+    const std::array<const char *, properties> propNames{"thermal conductivity", "mass density", "specific heat", "resistivity"};
+    for (const auto & [matId, property] : required) {
+        if (hasProperty(matId, property)) continue;
+        m_valid = false;
+        auto material = nullptr == matLib ? nullptr : matLib->FindMaterialDefById(matId);
+        if (nullptr == material)
+            ECAD_ERROR("material %1% is not in the material library", matId);
+        else ECAD_ERROR("material %1% has no %2%", material->GetName(), propNames.at(static_cast<size_t>(property)));
+    }
+}
+
+ECAD_INLINE void EMaterialTable::Compile(EMaterialId matId, Property property, CPtr<IMaterialProp> prop)
+{
+    if (nullptr == prop) return;
+    auto index = (static_cast<size_t>(matId) * properties + static_cast<size_t>(property)) * components;
+    if (m_curves.size() < index + components)
+        m_curves.resize((static_cast<size_t>(matId) + 1) * properties * components);
+
+    auto append = [&](size_t row, const std::vector<EFloat> & coefficients) {
+        auto & curve = m_curves[index + row];
+        curve.offset = static_cast<uint32_t>(m_coefficients.size());
+        curve.size = static_cast<uint32_t>(coefficients.size());
+        m_coefficients.insert(m_coefficients.end(), coefficients.begin(), coefficients.end());
+    };
+
+    //component selection follows GetAnisotropicProperty() of the prop, the simple lookup is the first component
+    if (prop->isPropValue()) {
+        auto value = dynamic_cast<CPtr<IMaterialPropValue>>(prop); { ECAD_ASSERT(value) }
+        for (size_t row = 0; row < components; ++row) {
+            EFloat c{0};
+            [[maybe_unused]] auto check = value->GetAnisotropicProperty(row, c); { ECAD_ASSERT(check) }
+            append(row, {c});
+        }
+    }
+    else if (auto polynomial = dynamic_cast<CPtr<IMaterialPropPolynomial>>(prop); polynomial && prop->isPropPolynomial()) {
+        const auto & coefficients = polynomial->GetCoefficients();
+        if (coefficients.empty()) return;
+        for (size_t row = 0; row < components; ++row) {
+            const auto & coeffs = components == coefficients.size() ? coefficients.at(row) : coefficients.front();
+            ECAD_ASSERT(not coeffs.empty())
+            append(row, coeffs);
+        }
+    }
+    else {
+        for (size_t row = 0; row < components; ++row) {
+            auto & curve = m_curves[index + row];
+            curve.size = 1;
+            curve.fallback = prop;
+        }
+    }
+}
+
+} // namespace ecad::solver
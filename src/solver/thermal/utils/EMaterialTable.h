@@ -0,0 +1,107 @@
+#pragma once
+#include "interface/IMaterialProp.h"
+#include <limits>
+#include <array>
+#include <set>
+namespace ecad {
+
+class IMaterialDefCollection;
+namespace solver {
+
+///@brief material library compiled into flat polynomial curves addressed by material id, property and component,
+///       evaluated without virtual dispatch or map lookups, constant properties are polynomials of degree zero,
+///       property kinds without closed form keep the material prop and are evaluated through it,
+///       the properties a model needs are checked once when the table is compiled
+class ECAD_API EMaterialTable
+{
+public:
+    enum class Property { ThermalConductivity = 0, MassDensity, SpecificHeat, Resistivity, Count };
+    using Requirements = std::set<std::pair<EMaterialId, Property> >;
+
+    ///@param required, material properties the caller evaluates, each missing one is reported and makes the table invalid
+    explicit EMaterialTable(CPtr<IMaterialDefCollection> matLib, const Requirements & required = {});
+
+    bool isValid() const { return m_valid; }
+    bool hasProperty(EMaterialId matId, Property property) const;
+
+    ///@brief same result as IMaterialProp::GetSimpleProperty(refT, value), NaN if the material or property is missing
+    EFloat GetSimpleProperty(EMaterialId matId, Property property, EFloat refT) const;
+    ///@brief same result as IMaterialProp::GetAnisotropicProperty(refT, row, value) for each row, NaN if the material or property is missing
+    std::array<EFloat, 3> GetAnisotropicProperty(EMaterialId matId, Property property, EFloat refT) const;
+
+private:
+    struct Curve
+    {
+        uint32_t offset{0};
+        uint32_t size{0};//number of coefficients, 0 if the property is missing
+        CPtr<IMaterialProp> fallback{nullptr};
+    };
+
+    static constexpr size_t components = 3;
+    static constexpr size_t properties = static_cast<size_t>(Property::Count);
+    static constexpr size_t simple = components;//row of a simple lookup, evaluates the first component
+
+    void Compile(EMaterialId matId, Property property, CPtr<IMaterialProp> prop);
+    ///@brief index of the first row curve, m_curves.size() if the material id is out of range
+    size_t CurveIndex(EMaterialId matId, Property property) const;
+    const Curve & GetCurve(EMaterialId matId, Property property, size_t row) const;
+    EFloat Evaluate(const Curve & curve, size_t row, EFloat refT) const;
+
+private:
+    std::vector<Curve> m_curves;//[material id][property][row]
+    std::vector<EFloat> m_coefficients;
+    std::array<Curve, components> m_missing;//empty curves returned for unknown material ids
+    bool m_valid{true};
+};
+
+ECAD_ALWAYS_INLINE bool EMaterialTable::hasProperty(EMaterialId matId, Property property) const
+{
+    auto index = CurveIndex(matId, property);
+    return index < m_curves.size() && m_curves[index].size > 0;
+}
+
+ECAD_ALWAYS_INLINE EFloat EMaterialTable::GetSimpleProperty(EMaterialId matId, Property property, EFloat refT) const
+{
+    return Evaluate(GetCurve(matId, property, 0), simple, refT);
+}
+
+ECAD_ALWAYS_INLINE std::array<EFloat, 3> EMaterialTable::GetAnisotropicProperty(EMaterialId matId, Property property, EFloat refT) const
+{
+    const auto * curves = &GetCurve(matId, property, 0);
+    return {Evaluate(curves[0], 0, refT), Evaluate(curves[1], 1, refT), Evaluate(curves[2], 2, refT)};
+}
+
+ECAD_ALWAYS_INLINE const EMaterialTable::Curve & EMaterialTable::GetCurve(EMaterialId matId, Property property, size_t row) const
+{
+    auto index = CurveIndex(matId, property);
+    if (index >= m_curves.size()) return m_missing[row];
+    return m_curves[index + row];
+}
+
+ECAD_ALWAYS_INLINE size_t EMaterialTable::CurveIndex(EMaterialId matId, Property property) const
+{
+    if (matId < 0 || static_cast<size_t>(matId) >= m_curves.size() / (properties * components)) return m_curves.size();
+    return (static_cast<size_t>(matId) * properties + static_cast<size_t>(property)) * components;
+}
+
+ECAD_ALWAYS_INLINE EFloat EMaterialTable::Evaluate(const Curve & curve, size_t row, EFloat refT) const
+{
+    if (nullptr != curve.fallback) {
+        EFloat value{0};
+        [[maybe_unused]] auto check = simple == row ? curve.fallback->GetSimpleProperty(refT, value) :
+                                                      curve.fallback->GetAnisotropicProperty(refT, row, value);
+        ECAD_ASSERT(check)
+        return value;
+    }
+    //only reachable for properties that were not required when the table was compiled
+    if (0 == curve.size) return std::numeric_limits<EFloat>::quiet_NaN();
+    //horner
+    const auto * c = m_coefficients.data() + curve.offset;
+    EFloat value = c[curve.size - 1];
+    for (size_t i = curve.size - 1; i > 0; --i)
+        value = value * refT + c[i - 1];
+    return value;
+}
+
+} // namespace solver
+} // namespace ecad
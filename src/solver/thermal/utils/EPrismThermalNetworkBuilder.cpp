@@ -13,7 +13,7 @@ using namespace ecad::model;
 
 template <typename Scalar>
 ECAD_INLINE EPrismThermalNetworkBuilder<Scalar>::EPrismThermalNetworkBuilder(const ModelType & model)
- : m_model(model)
+ : m_model(model), m_matTable(model.GetMaterialLibrary(), MaterialRequirements(model))
 {
 }
 
@@ -22,84 +22,222 @@ ECAD_INLINE UPtr<typename EPrismThermalNetworkBuilder<Scalar>::Network> EPrismTh
 {
     const size_t size = m_model.TotalElements();
     if(iniT.size() != size) return nullptr;
+    if (not m_matTable.isValid()) return nullptr;
 
+    PrepareGeometry(threads);
     summary.Reset();
     summary.totalNodes = size;
     auto network = std::make_unique<Network>(size);
+    CountPrismElementEdges(network.get());
+    CountLineElementEdges(network.get());
+    network->AllocateR();
+    Assemble(iniT, network.get(), threads);
+    network->Compress();
+    return network;
+}
+
+template <typename Scalar>
+ECAD_INLINE bool EPrismThermalNetworkBuilder<Scalar>::Update(const std::vector<Scalar> & iniT, Network & network, size_t threads) const
+{
+    const size_t size = m_model.TotalElements();
+    if (iniT.size() != size || network.Size() != size || not network.isCompressed()) return false;
+    if (not m_matTable.isValid()) return false;
+
+    PrepareGeometry(threads);
+    summary.Reset();
+    summary.totalNodes = size;
+    network.ResetValues();
+    Assemble(iniT, &network, threads);
+    //an edge missing from the adjacency is kept pending, the network was not built from this model
+    if (network.isCompressed()) return true;
+    network.Compress();
+    return false;
+}
+
+template <typename Scalar>
+ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::Assemble(const std::vector<Scalar> & iniT, Ptr<Network> network, size_t threads) const
+{
+    //each prism only writes its own node data and CSR row, the summary and the edges not counted in advance
+    //are collected per chunk and merged in chunk order so the result does not depend on the thread count
+    const size_t prisms = m_model.TotalPrismElements();
+    const size_t chunks = (prisms + prismChunkSize - 1) / prismChunkSize;
+    std::vector<EThermalNetworkBuildSummary> partials(chunks);
+    std::vector<std::vector<Edge> > pendings(chunks);
+    auto buildChunk = [&](size_t chunk) {
+        auto begin = chunk * prismChunkSize;
+        auto end = std::min(begin + prismChunkSize, prisms);
+        BuildPrismElement(iniT, network, begin, end, partials[chunk], pendings[chunk]);
+    };
+    if (threads > 1 && chunks > 1) {
+        generic::thread::ThreadPool pool(std::min(threads, chunks));
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+            pool.Submit(std::bind(buildChunk, chunk));
+    }
+    else {
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+            buildChunk(chunk);
+    }
+    for (const auto & partial : partials)
+        summary.Merge(partial);
+    for (const auto & pending : pendings)
+        network->AppendPendingR(pending);
+
+    BuildLineElement(iniT, network);
+    ApplyBlockBCs(network);
+}
 
-    if (threads > 1) {
-        generic::thread::ThreadPool pool(threads);
-        size_t size = m_model.TotalPrismElements();
-        size_t blocks = pool.Threads();
-        size_t blockSize = size / blocks;
-
-        size_t begin = 0;
-        for(size_t i = 0; i < blocks && blockSize > 0; ++i){
-            size_t end = begin + blockSize;
-            pool.Submit(std::bind(&EPrismThermalNetworkBuilder::BuildPrismElement, this, std::ref(iniT), network.get(), begin, end));
-            begin = end;
+template <typename Scalar>
+ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::PrepareGeometry(size_t threads) const
+{
+    std::call_once(m_prepared, [&] {
+        const size_t prisms = m_model.TotalPrismElements();
+        const size_t chunks = (prisms + prismChunkSize - 1) / prismChunkSize;
+        m_prismGeometry.assign(prisms, PrismGeometry{});
+        auto prepareChunk = [&](size_t chunk) {
+            auto begin = chunk * prismChunkSize;
+            auto end = std::min(begin + prismChunkSize, prisms);
+            for (size_t i = begin; i < end; ++i) {
+                auto & geom = m_prismGeometry[i];
+                geom.height = GetPrismHeight(i);
+                geom.hArea = GetPrismTopBotArea(i);
+                auto ct = GetPrismCenterPoint2D(i);
+                const auto & neighbors = m_model.GetPrism(i).neighbors;
+                for (size_t ie = 0; ie < 3; ++ie) {
+                    geom.vArea[ie] = GetPrismSideArea(i, ie);
+                    geom.dist2Side[ie] = GetPrismCenterDist2Side(i, ie);
+                    if (auto nid = neighbors.at(ie); tri::noNeighbor != nid)
+                        geom.nbDist[ie] = (GetPrismCenterPoint2D(nid) - ct).Norm2() * m_model.UnitScale2Meter();
+                }
+            }
+        };
+        if (threads > 1 && chunks > 1) {
+            generic::thread::ThreadPool pool(std::min(threads, chunks));
+            for (size_t chunk = 0; chunk < chunks; ++chunk)
+                pool.Submit(std::bind(prepareChunk, chunk));
         }
-        size_t end = size;
-        if(begin != end)
-            pool.Submit(std::bind(&EPrismThermalNetworkBuilder::BuildPrismElement, this, std::ref(iniT), network.get(), begin, end));        
+        else {
+            for (size_t chunk = 0; chunk < chunks; ++chunk)
+                prepareChunk(chunk);
+        }
+
+        m_lineGeometry.resize(m_model.TotalLineElements());
+        for (size_t i = 0; i < m_lineGeometry.size(); ++i) {
+            auto index = m_model.GetLine(i).id;
+            m_lineGeometry[i] = LineGeometry{GetLineLength(index), GetLineArea(index)};
+        }
+
+        m_blockBCs.clear();
+        CollectBlockBCs(m_blockBCs);
+    });
+}
+
+template <typename Scalar>
+ECAD_INLINE EMaterialTable::Requirements EPrismThermalNetworkBuilder<Scalar>::MaterialRequirements(const ModelType & model)
+{
+    using Property = EMaterialTable::Property;
+    EMaterialTable::Requirements required;
+    auto require = [&](EMaterialId matId) {
+        for (auto property : {Property::ThermalConductivity, Property::MassDensity, Property::SpecificHeat})
+            required.emplace(matId, property);
+    };
+    for (const auto & layer : model.layers) {
+        for (const auto & element : layer.elements)
+            require(element.matId);
     }
-    else BuildPrismElement(iniT, network.get(), 0, m_model.TotalPrismElements());
-    
-    BuildLineElement(iniT, network.get());
-    ApplyBlockBCs(network.get());
-    return network;
+    for (size_t i = 0; i < model.TotalLineElements(); ++i) {
+        const auto & line = model.GetLine(i);
+        require(line.matId);
+        if (not generic::math::EQ<EFloat>(line.current, 0))
+            required.emplace(line.matId, Property::Resistivity);
+    }
+    return required;
 }
 
 template <typename Scalar>
-ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::BuildPrismElement(const std::vector<Scalar> & iniT, Ptr<Network> network, size_t start, size_t end) const
+ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::CountPrismElementEdges(Ptr<Network> network) const
+{
+    for (size_t i = 0; i < m_model.TotalPrismElements(); ++i) {
+        for (auto nid : m_model.GetPrism(i).neighbors) {
+            if (tri::noNeighbor != nid && i < nid)
+                network->CountR(i, nid);
+        }
+    }
+}
+
+template <typename Scalar>
+ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::CountLineElementEdges(Ptr<Network> network) const
+{
+    for (size_t i = 0; i < m_model.TotalLineElements(); ++i) {
+        const auto & line = m_model.GetLine(i);
+        auto index = line.id;
+        auto countR = [&](size_t nbIndex) {
+            if (m_model.isPrima(nbIndex) || index < nbIndex)
+                network->CountR(index, nbIndex);
+        };
+        for (auto nb : line.neighbors.front()) countR(nb);
+        for (auto nb : line.neighbors.back()) countR(nb);
+    }
+}
+
+template <typename Scalar>
+ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::BuildPrismElement(const std::vector<Scalar> & iniT, Ptr<Network> network, size_t start, size_t end, EThermalNetworkBuildSummary & summary, std::vector<Edge> & pending) const
 {
     auto topBC = m_model.GetUniformBC(EOrientation::Top);
     auto botBC = m_model.GetUniformBC(EOrientation::Bot);
-    
+
+    //power tables are looked up in batches over runs of prisms sharing the same table
+    std::vector<EFloat> power(end - start, 0);
+    for (size_t i = start, next = start; i < end; i = next) {
+        const auto & inst = m_model.GetPrism(i);
+        const auto & lut = m_model.GetPrismElement(inst.layer, inst.element).powerLut;
+        for (next = i + 1; next < end; ++next) {
+            const auto & nextInst = m_model.GetPrism(next);
+            if (m_model.GetPrismElement(nextInst.layer, nextInst.element).powerLut != lut) break;
+        }
+        if (lut) lut->Lookup(&iniT.at(i), &power[i - start], next - i);
+    }
+
     for (size_t i = start; i < end; ++i) {
         const auto & inst = m_model.GetPrism(i);
         const auto & element = m_model.GetPrismElement(inst.layer, inst.element);
-        if (const auto & lut = element.powerLut; lut) {
-            auto p = lut->Lookup(iniT.at(i));
-            p *= element.powerRatio;
+        if (element.powerLut) {
+            auto p = power[i - start] * element.powerRatio;
             summary.iHeatFlow += p;
             network->AddHF(i, p);
             network->SetScenario(i, element.powerScenario);
         }
 
+        const auto & geom = GetPrismGeometry(i);
         auto c = GetMatSpecificHeat(element.matId, iniT.at(i));
         auto rho = GetMatMassDensity(element.matId, iniT.at(i));
-        auto vol = GetPrismVolume(i);
+        auto vol = geom.hArea * geom.height;
         network->SetC(i, c * rho * vol);
 
         auto k = GetMatThermalConductivity(element.matId, iniT.at(i));
-        auto ct = GetPrismCenterPoint2D(i);
 
         const auto & neighbors = inst.neighbors;
         //edges
         for (size_t ie = 0; ie < 3; ++ie) {
-            auto vArea = GetPrismSideArea(i, ie);
+            auto vArea = geom.vArea[ie];
             if (auto nid = neighbors.at(ie); tri::noNeighbor == nid) {
                 //todo, side bc
             }
             else if (i < nid) { //one way
                 const auto & nb = m_model.GetPrism(nid);
                 const auto & nbEle = m_model.GetPrismElement(nb.layer, nb.element);
-                auto ctNb = GetPrismCenterPoint2D(nid);
-                auto vec = ctNb - ct;
-                auto dist = vec.Norm2() * m_model.UnitScale2Meter();
+                auto dist = geom.nbDist[ie];
                 auto kxy = 0.5 * (k[0] + k[1]);
-                auto dist2edge = GetPrismCenterDist2Side(i, ie);
+                auto dist2edge = geom.dist2Side[ie];
                 auto r1 = dist2edge / kxy / vArea;
 
                 auto kNb = GetMatThermalConductivity(nbEle.matId, iniT.at(nid));
                 auto kNbXY = 0.5 * (kNb[0] + kNb[1]);
                 auto r2 = (dist - dist2edge) / kNbXY / vArea;
-                network->SetR(i, nid, r1 + r2);
+                network->SetR(i, nid, r1 + r2, &pending);
             }
         }
-        auto height = GetPrismHeight(i);
-        auto hArea = GetPrismTopBotArea(i);
+        auto height = geom.height;
+        auto hArea = geom.hArea;
         //top
         auto nTop = neighbors.at(PrismElement::TOP_NEIGHBOR_INDEX);
         if (tri::noNeighbor == nTop) {
@@ -120,10 +258,10 @@ ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::BuildPrismElement(const st
         else if (i < nTop) {
             const auto & nb = m_model.GetPrism(nTop);
             const auto & nbEle = m_model.GetPrismElement(nb.layer, nb.element);
-            auto hNb = GetPrismHeight(nTop);
+            auto hNb = GetPrismGeometry(nTop).height;
             auto kNb = GetMatThermalConductivity(nbEle.matId, iniT.at(nTop));
             auto r = (0.5 * height / k[2] + 0.5 * hNb / kNb[2]) / hArea;
-            network->SetR(i, nTop, r);
+            network->SetR(i, nTop, r, &pending);
         }
         //bot
         auto nBot = neighbors.at(PrismElement::BOT_NEIGHBOR_INDEX);
@@ -145,10 +283,10 @@ ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::BuildPrismElement(const st
         else if (i < nBot) {
             const auto & nb = m_model.GetPrism(nBot);
             const auto & nbEle = m_model.GetPrismElement(nb.layer, nb.element);
-            auto hNb = GetPrismHeight(nBot);
+            auto hNb = GetPrismGeometry(nBot).height;
             auto kNb = GetMatThermalConductivity(nbEle.matId, iniT.at(nBot));
             auto r = (0.5 * height / k[2] + 0.5 * hNb / kNb[2]) / hArea;
-            network->SetR(i, nBot, r);
+            network->SetR(i, nBot, r, &pending);
         }
     }
 }
@@ -159,13 +297,15 @@ ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::BuildLineElement(const std
     for (size_t i = 0; i < m_model.TotalLineElements(); ++i) {
         const auto & line = m_model.GetLine(i);
         auto index = line.id;
+        const auto & geom = GetLineGeometry(i);
         auto rho = GetMatMassDensity(line.matId, iniT.at(index));
         auto c = GetMatSpecificHeat(line.matId, iniT.at(index));
-        auto v = GetLineVolume(index);
+        auto v = geom.area * geom.length;
         network->SetC(index, c * rho * v);
 
         network->SetScenario(index, line.scenario);
-        if (auto jh = GetLineJouleHeat(index, iniT.at(index)); jh > 0) {
+        auto jh = GetLineJouleHeat(index, iniT.at(index));
+        if (jh > 0) {
             network->AddHF(index, jh);
             summary.iHeatFlow += jh;
             summary.jouleHeat += jh;
@@ -173,8 +313,8 @@ ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::BuildLineElement(const std
         
         auto k = GetMatThermalConductivity(line.matId, iniT.at(index));
         auto aveK = (k[0] + k[1] + k[2]) / 3;
-        auto area = GetLineArea(index);
-        auto l = GetLineLength(index);
+        auto area = geom.area;
+        auto l = geom.length;
 
         auto setR = [&](size_t nbIndex) {
             if (m_model.isPrima(nbIndex)) {
@@ -182,11 +322,12 @@ ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::BuildLineElement(const std
                 network->SetR(nbIndex, index, r);
             }
             else if (index < nbIndex) {
-                const auto & lineNb = m_model.GetLine(m_model.LineLocalIndex(nbIndex));
+                auto nbLocal = m_model.LineLocalIndex(nbIndex);
+                const auto & lineNb = m_model.GetLine(nbLocal);
                 auto kNb = GetMatThermalConductivity(lineNb.matId, iniT.at(index));
                 auto aveKNb = (kNb[0] + kNb[1] + kNb[2]) / 3;
-                auto areaNb = GetLineArea(nbIndex);
-                auto lNb = GetLineLength(nbIndex);
+                auto areaNb = GetLineGeometry(nbLocal).area;
+                auto lNb = GetLineGeometry(nbLocal).length;
                 auto r = 0.5 * l / aveK / area + 0.5 * lNb / aveKNb / areaNb;
                 network->SetR(index, nbIndex, r);
             }
@@ -197,7 +338,7 @@ ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::BuildLineElement(const std
 }
 
 template <typename Scalar>
-ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::ApplyBlockBCs(Ptr<Network> network) const
+ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::CollectBlockBCs(std::vector<BlockBC> & bcs) const
 {
     const auto & topBCs = m_model.GetBlockBCs(EOrientation::Top);
     const auto & botBCs = m_model.GetBlockBCs(EOrientation::Bot);
@@ -206,7 +347,7 @@ ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::ApplyBlockBCs(Ptr<Network>
     model::utils::EPrismThermalModelQuery query(&m_model);
     using RtVal = model::utils::EPrismThermalModelQuery::RtVal;
 
-    auto applyBlockBC = [&](const auto & block, bool isTop)
+    auto collectBlockBC = [&](const auto & block, bool isTop)
     {
         std::vector<RtVal> results;
         if (not block.second.isValid()) return;
@@ -221,25 +362,33 @@ ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::ApplyBlockBCs(Ptr<Network>
                                    PrismElement::BOT_NEIGHBOR_INDEX ;
                 if (element.neighbors.at(nid) != noNeighbor) continue;
                 auto area = GetPrismTopBotArea(result.second);
-                if (EThermalBoundaryCondition::BCType::HeatFlux == block.second.type) {
-                    auto heatFlow = value * area;
-                    network->SetHF(result.second, heatFlow);
-                    if (heatFlow > 0)
-                        summary.iHeatFlow += heatFlow;
-                    else summary.oHeatFlow += heatFlow;
-                }
-                else { 
-                    network->SetHTC(result.second, value * area);
-                    summary.boundaryNodes += 1;
-                }
+                auto isHTC = EThermalBoundaryCondition::BCType::HeatFlux != block.second.type;
+                bcs.emplace_back(BlockBC{result.second, isHTC, value * area});
             }    
         }
     };
 
     for (const auto & block : topBCs)
-        applyBlockBC(block, true);
+        collectBlockBC(block, true);
     for (const auto & block : botBCs)
-        applyBlockBC(block, false);
+        collectBlockBC(block, false);
+}
+
+template <typename Scalar>
+ECAD_INLINE void EPrismThermalNetworkBuilder<Scalar>::ApplyBlockBCs(Ptr<Network> network) const
+{
+    for (const auto & bc : m_blockBCs) {
+        if (bc.isHTC) {
+            network->SetHTC(bc.node, bc.value);
+            summary.boundaryNodes += 1;
+        }
+        else {
+            network->SetHF(bc.node, bc.value);
+            if (bc.value > 0)
+                summary.iHeatFlow += bc.value;
+            else summary.oHeatFlow += bc.value;
+        }
+    }
 }
 
 template <typename Scalar>
@@ -318,10 +467,12 @@ ECAD_INLINE EFloat EPrismThermalNetworkBuilder<Scalar>::GetPrismHeight(size_t in
 template <typename Scalar>
 ECAD_INLINE EFloat EPrismThermalNetworkBuilder<Scalar>::GetLineJouleHeat(size_t index, EFloat refT) const
 {
-    const auto & line = m_model.GetLine(m_model.LineLocalIndex(index));
+    auto local = m_model.LineLocalIndex(index);
+    const auto & line = m_model.GetLine(local);
     if (generic::math::EQ<EFloat>(line.current, 0)) return 0;
+    const auto & geom = GetLineGeometry(local);
     auto rho = GetMatResistivity(line.matId, refT);
-    return rho * GetLineLength(index) * line.current * line.current / GetLineArea(index);
+    return rho * geom.length * line.current * line.current / geom.area;
 }
 
 template <typename Scalar>
@@ -349,43 +500,25 @@ ECAD_INLINE EFloat EPrismThermalNetworkBuilder<Scalar>::GetLineArea(size_t index
 template <typename Scalar>
 ECAD_INLINE std::array<EFloat, 3> EPrismThermalNetworkBuilder<Scalar>::GetMatThermalConductivity(EMaterialId matId, EFloat refT) const
 {
-    std::array<EFloat, 3> result;
-    auto material = m_model.GetMaterialLibrary()->FindMaterialDefById(matId); { ECAD_ASSERT(material) }
-    for (size_t i = 0; i < result.size(); ++i) {
-        [[maybe_unused]] auto check = material->GetProperty(EMaterialPropId::ThermalConductivity)->GetAnisotropicProperty(refT, i, result[i]);
-        ECAD_ASSERT(check)
-    }
-    return result;
+    return m_matTable.GetAnisotropicProperty(matId, EMaterialTable::Property::ThermalConductivity, refT);
 }
 
 template <typename Scalar>
 ECAD_INLINE EFloat EPrismThermalNetworkBuilder<Scalar>::GetMatMassDensity(EMaterialId matId, EFloat refT) const
 {
-    EFloat result{0};
-    auto material = m_model.GetMaterialLibrary()->FindMaterialDefById(matId); { ECAD_ASSERT(material) }
-    [[maybe_unused]] auto check = material->GetProperty(EMaterialPropId::MassDensity)->GetSimpleProperty(refT, result);
-    ECAD_ASSERT(check)
-    return result;
+    return m_matTable.GetSimpleProperty(matId, EMaterialTable::Property::MassDensity, refT);
 }
 
 template <typename Scalar>
 ECAD_INLINE EFloat EPrismThermalNetworkBuilder<Scalar>::GetMatSpecificHeat(EMaterialId matId, EFloat refT) const
 {
-    EFloat result{0};
-    auto material = m_model.GetMaterialLibrary()->FindMaterialDefById(matId); { ECAD_ASSERT(material) }
-    [[maybe_unused]] auto check = material->GetProperty(EMaterialPropId::SpecificHeat)->GetSimpleProperty(refT, result);
-    ECAD_ASSERT(check)
-    return result;
+    return m_matTable.GetSimpleProperty(matId, EMaterialTable::Property::SpecificHeat, refT);
 }
 
 template <typename Scalar>
 ECAD_INLINE EFloat EPrismThermalNetworkBuilder<Scalar>::GetMatResistivity(EMaterialId matId, EFloat refT) const
 {
-    EFloat result{0};
-    auto material = m_model.GetMaterialLibrary()->FindMaterialDefById(matId); { ECAD_ASSERT(material) }
-    [[maybe_unused]] auto check = material->GetProperty(EMaterialPropId::Resistivity)->GetSimpleProperty(refT, result);
-    ECAD_ASSERT(check)
-    return result; 
+    return m_matTable.GetSimpleProperty(matId, EMaterialTable::Property::Resistivity, refT);
 }
 
 template ECAD_INLINE class EPrismThermalNetworkBuilder<Float32>;
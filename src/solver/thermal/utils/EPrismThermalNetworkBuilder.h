@@ -1,7 +1,9 @@
 #pragma once
 #include "EThermalNetworkBuilder.h"
+#include "EMaterialTable.h"
 #include "model/thermal/EPrismThermalModel.h"
 #include "solver/thermal/network/ThermalNetwork.h"
+#include <mutex>
 namespace ecad::solver {
 
 using namespace model;
@@ -13,15 +15,59 @@ class ECAD_API EPrismThermalNetworkBuilder : public EThermalNetworkBuilder
 public:
     using ModelType = EPrismThermalModel;
     using Network = thermal::model::ThermalNetwork<Scalar>;
+    using Edge = typename Network::Edge;
+    ///@brief prisms per assembly job, fixed so the summary merge order is independent of the thread count
+    static constexpr size_t prismChunkSize = 4096;
     explicit EPrismThermalNetworkBuilder(const ModelType & model);
     virtual ~EPrismThermalNetworkBuilder() = default;
 
+    ///@brief returns nullptr if iniT does not match the model or a material property used by the model is missing
     UPtr<Network > Build(const std::vector<Scalar> & iniT, size_t threads = 1) const;
+    ///@brief reassembles a network from a previous Build() of this builder in place for new temperatures,
+    ///       the adjacency and node order are kept, returns false if the network does not match the model
+    bool Update(const std::vector<Scalar> & iniT, Network & network, size_t threads = 1) const;
 
 protected:
-    virtual void BuildPrismElement(const std::vector<Scalar> & iniT, Ptr<Network> network, size_t start, size_t end) const;
-    virtual void ApplyBlockBCs(Ptr<Network> network) const;
+    ///@brief temperature independent factors of a prism, unit: SI
+    struct PrismGeometry
+    {
+        EFloat height{0};
+        EFloat hArea{0};//top and bottom area
+        std::array<EFloat, 3> vArea{0, 0, 0};//side areas
+        std::array<EFloat, 3> dist2Side{0, 0, 0};
+        std::array<EFloat, 3> nbDist{0, 0, 0};//center distance to the edge neighbors
+    };
+
+    ///@brief temperature independent factors of a line, unit: SI
+    struct LineGeometry
+    {
+        EFloat length{0};
+        EFloat area{0};
+    };
+
+    ///@brief value of a block boundary condition applied to the top or bottom face of a prism
+    struct BlockBC
+    {
+        size_t node;
+        bool isHTC;
+        EFloat value;
+    };
+
+    ///@brief material properties the assembly evaluates for the elements of the model
+    static EMaterialTable::Requirements MaterialRequirements(const ModelType & model);
+    virtual void CountPrismElementEdges(Ptr<Network> network) const;
+    virtual void BuildPrismElement(const std::vector<Scalar> & iniT, Ptr<Network> network, size_t start, size_t end, EThermalNetworkBuildSummary & summary, std::vector<Edge> & pending) const;
+    virtual void CollectBlockBCs(std::vector<BlockBC> & bcs) const;
+    void CountLineElementEdges(Ptr<Network> network) const;
     void BuildLineElement(const std::vector<Scalar> & iniT, Ptr<Network> network) const;
+    void ApplyBlockBCs(Ptr<Network> network) const;
+    void Assemble(const std::vector<Scalar> & iniT, Ptr<Network> network, size_t threads) const;
+
+    ///@brief computes the geometry factors and block boundary conditions on the first call, later builds reuse them,
+    ///       safe to call from concurrent builds
+    void PrepareGeometry(size_t threads) const;
+    const PrismGeometry & GetPrismGeometry(size_t index) const { return m_prismGeometry[index]; }
+    const LineGeometry & GetLineGeometry(size_t local) const { return m_lineGeometry[local]; }
 
     std::array<EFloat, 3> GetMatThermalConductivity(EMaterialId matId, EFloat refT) const;
     EFloat GetMatMassDensity(EMaterialId matId, EFloat refT) const;
@@ -41,6 +87,7 @@ protected:
     EFloat GetPrismVolume(size_t index) const;
     EFloat GetPrismHeight(size_t index) const;
 
+    ///@brief uses the cached line geometry, valid after PrepareGeometry()
     EFloat GetLineJouleHeat(size_t index, EFloat refT) const;
     EFloat GetLineVolume(size_t index) const;
     EFloat GetLineLength(size_t index) const;
@@ -48,6 +95,11 @@ protected:
 
 protected:
     const ModelType & m_model;
+    const EMaterialTable m_matTable;
+    mutable std::once_flag m_prepared;//the geometry cache below is written once, concurrent builds wait for it
+    mutable std::vector<PrismGeometry> m_prismGeometry;
+    mutable std::vector<LineGeometry> m_lineGeometry;//by line local index
+    mutable std::vector<BlockBC> m_blockBCs;
 };
 } // namespace ecad::solver
 
@@ -18,57 +18,84 @@ ECAD_INLINE EStackupPrismThermalNetworkBuilder<Scalar>::EStackupPrismThermalNetw
 }
 
 template <typename Scalar>
-ECAD_INLINE void EStackupPrismThermalNetworkBuilder<Scalar>::BuildPrismElement(const std::vector<Scalar> & iniT, Ptr<Network> network, size_t start, size_t end) const
+ECAD_INLINE void EStackupPrismThermalNetworkBuilder<Scalar>::CountPrismElementEdges(Ptr<Network> network) const
+{
+    const auto & model = this->m_model;
+    for (size_t i = 0; i < model.TotalPrismElements(); ++i) {
+        const auto & inst = model.GetPrism(i);
+        for (size_t ie = 0; ie < 3; ++ie) {
+            if (auto nid = inst.neighbors.at(ie); tri::noNeighbor != nid && i < nid)
+                network->CountR(i, nid);
+        }
+        for (const auto & contacts : inst.contactInstances) {
+            for (const auto & contact : contacts) {
+                if (i < contact.index)
+                    network->CountR(i, contact.index);
+            }
+        }
+    }
+}
+
+template <typename Scalar>
+ECAD_INLINE void EStackupPrismThermalNetworkBuilder<Scalar>::BuildPrismElement(const std::vector<Scalar> & iniT, Ptr<Network> network, size_t start, size_t end, EThermalNetworkBuildSummary & summary, std::vector<Edge> & pending) const
 {
     const auto & model = this->m_model;
     auto topBC = model.GetUniformBC(EOrientation::Top);
     auto botBC = model.GetUniformBC(EOrientation::Bot);
-    
-    auto & summary = EThermalNetworkBuilder::summary;
+
+    //power tables are looked up in batches over runs of prisms sharing the same table
+    std::vector<EFloat> power(end - start, 0);
+    for (size_t i = start, next = start; i < end; i = next) {
+        const auto & inst = model.GetPrism(i);
+        const auto & lut = model.GetPrismElement(inst.layer, inst.element).powerLut;
+        for (next = i + 1; next < end; ++next) {
+            const auto & nextInst = model.GetPrism(next);
+            if (model.GetPrismElement(nextInst.layer, nextInst.element).powerLut != lut) break;
+        }
+        if (lut) lut->Lookup(&iniT.at(i), &power[i - start], next - i);
+    }
+
     for (size_t i = start; i < end; ++i) {
         const auto & inst = model.GetPrism(i);
         const auto & element = model.GetPrismElement(inst.layer, inst.element);
-        if (const auto & lut = element.powerLut; lut) {
-            auto p = lut->Lookup(iniT.at(i));
-            p *= element.powerRatio;
+        if (element.powerLut) {
+            auto p = power[i - start] * element.powerRatio;
             summary.iHeatFlow += p;
             network->AddHF(i, p);
             network->SetScenario(i, element.powerScenario);
         }
 
+        const auto & geom = this->GetPrismGeometry(i);
         auto c = this->GetMatSpecificHeat(element.matId, iniT.at(i));
         auto rho = this->GetMatMassDensity(element.matId, iniT.at(i));
-        auto vol = this->GetPrismVolume(i);
+        auto vol = geom.hArea * geom.height;
         network->SetC(i, c * rho * vol);
 
         auto k = this->GetMatThermalConductivity(element.matId, iniT.at(i));
-        auto ct = this->GetPrismCenterPoint2D(i);
 
         const auto & neighbors = inst.neighbors;
         //edges
         for (size_t ie = 0; ie < 3; ++ie) {
-            auto vArea = this->GetPrismSideArea(i, ie);
+            auto vArea = geom.vArea[ie];
             if (auto nid = neighbors.at(ie); tri::noNeighbor == nid) {
                 //todo, side bc
             }
             else if (i < nid) { //one way
                 const auto & nb = model.GetPrism(nid);
                 const auto & nbEle = model.GetPrismElement(nb.layer, nb.element);
-                auto ctNb = this->GetPrismCenterPoint2D(nid);
-                auto vec = ctNb - ct;
-                auto dist = vec.Norm2() * model.UnitScale2Meter();
+                auto dist = geom.nbDist[ie];
                 auto kxy = 0.5 * (k[0] + k[1]);
-                auto dist2edge = this->GetPrismCenterDist2Side(i, ie);
+                auto dist2edge = geom.dist2Side[ie];
                 auto r1 = dist2edge / kxy / vArea;
 
                 auto kNb = this->GetMatThermalConductivity(nbEle.matId, iniT.at(nid));
                 auto kNbXY = 0.5 * (kNb[0] + kNb[1]);
                 auto r2 = (dist - dist2edge) / kNbXY / vArea;
-                network->SetR(i, nid, r1 + r2);
+                network->SetR(i, nid, r1 + r2, &pending);
             }
         }
-        auto height = this->GetPrismHeight(i);
-        auto hArea = this->GetPrismTopBotArea(i);
+        auto height = geom.height;
+        auto hArea = geom.hArea;
         //top
         auto nTop = neighbors.at(PrismElement::TOP_NEIGHBOR_INDEX);
         if (tri::noNeighbor == nTop) {
@@ -94,12 +121,12 @@ ECAD_INLINE void EStackupPrismThermalNetworkBuilder<Scalar>::BuildPrismElement(c
                 nTop = contact.index;
                 const auto & nb = model.GetPrism(nTop);
                 const auto & nbEle = model.GetPrismElement(nb.layer, nb.element);
-                auto hNb = this->GetPrismHeight(nTop);
+                auto hNb = this->GetPrismGeometry(nTop).height;
                 auto kNb = this->GetMatThermalConductivity(nbEle.matId, iniT.at(nTop));
                 auto area = hArea * contact.ratio;
                 auto r =  (0.5 * height / k[2] + 0.5 * hNb / kNb[2]) / area;
                 // auto r = 0.5 * height / k[2] / hArea + 0.5 * hNb / kNb[2] / GetPrismTopBotArea(nTop);
-                network->SetR(i, nTop, r);
+                network->SetR(i, nTop, r, &pending);
             }
             if (ratio > 0 && nullptr != topBC && topBC->isValid()) {
                 if (EThermalBoundaryCondition::BCType::HTC == topBC->type) {
@@ -142,12 +169,12 @@ ECAD_INLINE void EStackupPrismThermalNetworkBuilder<Scalar>::BuildPrismElement(c
                 nBot = contact.index;
                 const auto & nb = model.GetPrism(nBot);
                 const auto & nbEle = model.GetPrismElement(nb.layer, nb.element);
-                auto hNb = this->GetPrismHeight(nBot);
+                auto hNb = this->GetPrismGeometry(nBot).height;
                 auto kNb = this->GetMatThermalConductivity(nbEle.matId, iniT.at(nBot));
                 auto area = hArea * contact.ratio;
                 auto r =  (0.5 * height / k[2] + 0.5 * hNb / kNb[2]) / area;
                 // auto r = 0.5 * height / k[2] / hArea + 0.5 * hNb / kNb[2] / GetPrismTopBotArea(nBot);
-                network->SetR(i, nBot, r);
+                network->SetR(i, nBot, r, &pending);
             }
             if (ratio > 0 && nullptr != botBC && botBC->isValid()) {
                 if (EThermalBoundaryCondition::BCType::HTC == botBC->type) {
@@ -170,7 +197,7 @@ ECAD_INLINE void EStackupPrismThermalNetworkBuilder<Scalar>::BuildPrismElement(c
 }
 
 template <typename Scalar>
-ECAD_INLINE void EStackupPrismThermalNetworkBuilder<Scalar>::ApplyBlockBCs(Ptr<Network> network) const
+ECAD_INLINE void EStackupPrismThermalNetworkBuilder<Scalar>::CollectBlockBCs(std::vector<BlockBC> & bcs) const
 {
     const auto & model = this->m_model;
     const auto & topBCs = model.GetBlockBCs(EOrientation::Top);
@@ -180,8 +207,7 @@ ECAD_INLINE void EStackupPrismThermalNetworkBuilder<Scalar>::ApplyBlockBCs(Ptr<N
     model::utils::EStackupPrismThermalModelQuery query(dynamic_cast<CPtr<EStackupPrismThermalModel>>(&model));
     using RtVal = model::utils::EStackupPrismThermalModelQuery::RtVal;
     
-    auto & summary = EThermalNetworkBuilder::summary;
-    auto applyBlockBC = [&](const auto & block, bool isTop)
+    auto collectBlockBC = [&](const auto & block, bool isTop)
     {
         std::vector<RtVal> results;
         if (not block.second.isValid()) return;
@@ -199,25 +225,16 @@ ECAD_INLINE void EStackupPrismThermalNetworkBuilder<Scalar>::ApplyBlockBCs(Ptr<N
                                    PrismElement::BOT_NEIGHBOR_INDEX ;
                 if (element.neighbors.at(nid) != noNeighbor) continue;
                 auto area = this->GetPrismTopBotArea(result.second);
-                if (EThermalBoundaryCondition::BCType::HeatFlux == block.second.type) {
-                    auto heatFlow = value * area;
-                    network->SetHF(result.second, heatFlow);
-                    if (heatFlow > 0)
-                        summary.iHeatFlow += heatFlow;
-                    else summary.oHeatFlow += heatFlow;
-                }
-                else { 
-                    network->SetHTC(result.second, value * area);
-                    summary.boundaryNodes += 1;
-                }
+                auto isHTC = EThermalBoundaryCondition::BCType::HeatFlux != block.second.type;
+                bcs.emplace_back(BlockBC{result.second, isHTC, value * area});
             }    
         }
     };
 
     for (const auto & block : topBCs)
-        applyBlockBC(block, true);
+        collectBlockBC(block, true);
     for (const auto & block : botBCs)
-        applyBlockBC(block, false);
+        collectBlockBC(block, false);
 }
 
 template ECAD_INLINE class EStackupPrismThermalNetworkBuilder<Float32>;
@@ -13,12 +13,15 @@ class ECAD_API EStackupPrismThermalNetworkBuilder : public EPrismThermalNetworkB
 public:
     using ModelType = EStackupPrismThermalModel;
     using Network = typename EPrismThermalNetworkBuilder<Scalar>::Network;
+    using Edge = typename EPrismThermalNetworkBuilder<Scalar>::Edge;
+    using BlockBC = typename EPrismThermalNetworkBuilder<Scalar>::BlockBC;
     explicit EStackupPrismThermalNetworkBuilder(const ModelType & model);
     virtual ~EStackupPrismThermalNetworkBuilder() = default;
 
 private:
-    void BuildPrismElement(const std::vector<Scalar> & iniT, Ptr<Network> network, size_t start, size_t end) const override;
-    void ApplyBlockBCs(Ptr<Network> network) const override;
+    void CountPrismElementEdges(Ptr<Network> network) const override;
+    void BuildPrismElement(const std::vector<Scalar> & iniT, Ptr<Network> network, size_t start, size_t end, EThermalNetworkBuildSummary & summary, std::vector<Edge> & pending) const override;
+    void CollectBlockBCs(std::vector<BlockBC> & bcs) const override;
 };
 } // namespace ecad::solver
 
@@ -10,6 +10,15 @@ struct EThermalNetworkBuildSummary
     size_t boundaryNodes = 0;
     double iHeatFlow = 0, oHeatFlow = 0, jouleHeat = 0;
     void Reset() { *this = EThermalNetworkBuildSummary{}; }
+    ///@brief accumulates the per-element counters of a partial summary, totalNodes is kept
+    void Merge(const EThermalNetworkBuildSummary & other)
+    {
+        fixedTNodes += other.fixedTNodes;
+        boundaryNodes += other.boundaryNodes;
+        iHeatFlow += other.iHeatFlow;
+        oHeatFlow += other.oHeatFlow;
+        jouleHeat += other.jouleHeat;
+    }
 };
 
 class ECAD_API EThermalNetworkBuilder
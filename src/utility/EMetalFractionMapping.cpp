@@ -1,5 +1,6 @@
 #include "EMetalFractionMapping.h"
 
+#include "generic/thread/ThreadPool.hpp"
 #include "generic/geometry/Transform.hpp"
 #include "generic/tools/StringHelper.hpp"
 #include "generic/tools/FileSystem.hpp"
@@ -44,23 +45,26 @@ ECAD_INLINE void ELayerMetalFractionMapper::GenerateMetalFractionMapping(CPtr<IL
 
         auto geom = primitive->GetGeometry2DFromPrimitive();
         if(nullptr == geom) continue;
-        auto shape = geom->GetShape();
-        if(nullptr == shape) continue;
-
-        if(shape->hasHole()){
-            auto pwh = shape->GetPolygonWithHoles();
-            m_solids.emplace_back(std::move(pwh.outline));
-            for(auto & hole : pwh.holes)
-                m_holes.emplace_back(std::move(hole));
-        }
-        else {
-            auto polygon = shape->GetContour();
-            m_solids.emplace_back(std::move(polygon));
-        }
+        AddShape(geom->GetShape());
     }
     Mapping(ctrl);
 }
 
+ECAD_INLINE void ELayerMetalFractionMapper::AddShape(CPtr<EShape> shape)
+{
+    if(nullptr == shape) return;
+    if(shape->hasHole()){
+        auto pwh = shape->GetPolygonWithHoles();
+        m_solids.emplace_back(std::move(pwh.outline));
+        for(auto & hole : pwh.holes)
+            m_holes.emplace_back(std::move(hole));
+    }
+    else {
+        auto polygon = shape->GetContour();
+        m_solids.emplace_back(std::move(polygon));
+    }
+}
+
 ECAD_INLINE void ELayerMetalFractionMapper::Mapping(const MapCtrl & ctrl)
 {
     auto solidBlend = [](typename ELayerMetalFraction::ResultType & res, const Product & p) { res += p.ratio; };
@@ -84,6 +88,8 @@ ECAD_INLINE void ELayerMetalFractionMapper::Mapping(const MapCtrl & ctrl)
             if(res > 1.0f) res = 1.0f;
         }
     }
+    m_solids = std::vector<IntPolygon>{};
+    m_holes = std::vector<IntPolygon>{};
 }
 
 ECAD_INLINE ELayoutMetalFractionMapper::ELayoutMetalFractionMapper(EMetalFractionMappingSettings settings)
@@ -129,8 +135,8 @@ ECAD_INLINE bool ELayoutMetalFractionMapper::GenerateMetalFractionMapping(Ptr<IL
 
 
     m_result.reset(new ELayoutMetalFraction);
-    MapCtrl ctrl(bbox, {m_mfInfo->stride[0], m_mfInfo->stride[1]}, m_settings.threads);
-    
+    std::vector<UPtr<ELayerMetalFractionMapper> > mappers;
+    std::unordered_map<ELayerId, Ptr<ELayerMetalFractionMapper> > layerMappers;
     auto layerIter = layout->GetLayerIter();
     //stackuplayer
     while(auto * layer = layerIter->Next()){
@@ -138,14 +144,30 @@ ECAD_INLINE bool ELayoutMetalFractionMapper::GenerateMetalFractionMapping(Ptr<IL
         if(nullptr == stackupLayer) continue;
         bool isMetal = layer->GetLayerType() == ELayerType::ConductingLayer;
         auto layerFraction = std::make_shared<ELayerMetalFraction>(m_mfInfo->grid[0], m_mfInfo->grid[1], 0.0);
-        ELayerMetalFractionMapper mapper(m_settings, *layerFraction, layer->GetLayerId());
-        mapper.GenerateMetalFractionMapping(layout, ctrl);
+        mappers.emplace_back(new ELayerMetalFractionMapper(m_settings, *layerFraction, layer->GetLayerId()));
+        layerMappers.emplace(layer->GetLayerId(), mappers.back().get());
         m_result->push_back(layerFraction);
 
         EStackupLayerInfo lyrInfo{ isMetal, stackupLayer->GetElevation(), stackupLayer->GetThickness(), layer->GetName() };
         m_mfInfo->layers.emplace_back(std::move(lyrInfo));
     }
 
+    CollectLayerShapes(layout, bbox, layerMappers);
+
+    //map layers concurrently, the remaining threads go to the grid mapping of each layer
+    size_t layerThreads = std::max<size_t>(1, std::min(m_settings.threads, mappers.size()));
+    size_t gridThreads = std::max<size_t>(1, m_settings.threads / layerThreads);
+    MapCtrl ctrl(bbox, {m_mfInfo->stride[0], m_mfInfo->stride[1]}, gridThreads);
+    if(layerThreads > 1) {
+        generic::thread::ThreadPool pool(layerThreads);
+        for(const auto & mapper : mappers)
+            pool.Submit(std::bind(&ELayerMetalFractionMapper::Mapping, mapper.get(), std::cref(ctrl)));
+    }
+    else {
+        for(const auto & mapper : mappers)
+            mapper->Mapping(ctrl);
+    }
+
     bool res = true;
     if(!m_settings.outFile.empty()) {
         res = WriteResult2File(coordUnits.Scale2Unit());
@@ -166,6 +188,33 @@ ECAD_INLINE bool ELayoutMetalFractionMapper::GenerateMetalFractionMapping(Ptr<IL
     return res;
 }
 
+ECAD_INLINE void ELayoutMetalFractionMapper::CollectLayerShapes(CPtr<ILayoutView> layout, const EBox2D & extension, const std::unordered_map<ELayerId, Ptr<ELayerMetalFractionMapper> > & mappers) const
+{
+    auto outside = [&extension](const EBox2D & box) {
+        return box[1][0] < extension[0][0] || box[0][0] > extension[1][0] ||
+               box[1][1] < extension[0][1] || box[0][1] > extension[1][1];
+    };
+
+    bool bSelNet = m_settings.selectNets.size() > 0;
+    const auto & selNets = m_settings.selectNets;
+    auto primIter = layout->GetPrimitiveIter();
+    while(auto primitive = primIter->Next()){
+        auto layer = primitive->GetLayer();
+        if(noLayer == layer) continue;
+        auto iter = mappers.find(layer);
+        if(iter == mappers.cend()) continue;
+
+        auto netId = primitive->GetNet();
+        if(bSelNet && !selNets.count(netId)) continue;
+
+        auto geom = primitive->GetGeometry2DFromPrimitive();
+        if(nullptr == geom) continue;
+        auto shape = geom->GetShape();
+        if(nullptr == shape || outside(shape->GetBBox())) continue;
+        iter->second->AddShape(shape);
+    }
+}
+
 ECAD_INLINE CPtr<ELayoutMetalFraction> ELayoutMetalFractionMapper::GetLayoutMetalFraction() const
 {
     if(nullptr == m_result) return nullptr;
@@ -2,9 +2,11 @@
 #include "basic/ECadSettings.h"
 #include "generic/geometry/OccupancyGridMap.hpp"
 #include "generic/tools/FileSystem.hpp"
+#include <unordered_map>
 #include <vector>
 namespace ecad {
 
+class EShape;
 class ILayoutView;
 namespace utils {
 
@@ -27,7 +29,9 @@ public:
 
     void GenerateMetalFractionMapping(CPtr<ILayoutView> layout, const MapCtrl & ctrl);
 
-private:
+    ///@brief collects the solid and holes of a shape on this layer
+    void AddShape(CPtr<EShape> shape);
+    ///@brief maps the collected shapes to the grid, the collected shapes are released afterwards
     void Mapping(const MapCtrl & ctrl);
 
 private:
@@ -77,6 +81,7 @@ public:
     CPtr<EMetalFractionInfo> GetMetalFractionInfo() const;
 
 private:
+    void CollectLayerShapes(CPtr<ILayoutView> layout, const EBox2D & extension, const std::unordered_map<ELayerId, Ptr<ELayerMetalFractionMapper> > & mappers) const;
     bool WriteResult2File(double scale);
 
 private:
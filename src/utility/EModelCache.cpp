@@ -0,0 +1,382 @@
+#include "EModelCache.h"
+#include "model/thermal/EStackupPrismThermalModel.h"
+#include "model/thermal/EPrismThermalModel.h"
+#include "model/geometry/ELayerCutModel.h"
+#include "interface/Interface.h"
+#include "basic/EShape.h"
+
+#include "generic/tools/FileSystem.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <atomic>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif//_WIN32
+namespace ecad {
+namespace utils {
+
+namespace detail {
+
+///@brief 64-bit FNV-1a of everything written to the buffer
+class EDigestBuffer : public std::streambuf
+{
+public:
+    uint64_t Value() const { return m_value; }
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (not traits_type::eq_int_type(c, traits_type::eof())) Add(traits_type::to_char_type(c));
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char * s, std::streamsize n) override
+    {
+        for (std::streamsize i = 0; i < n; ++i) Add(s[i]);
+        return n;
+    }
+
+private:
+    void Add(char c) { m_value = (m_value ^ static_cast<uint8_t>(c)) * 1099511628211ull; }
+    uint64_t m_value{14695981039346656037ull};
+};
+
+///@brief plain values and temporary geometries are written raw, polymorphic objects owned by the layout go through the archive,
+///       the archive tracks objects by address so it must only see objects that outlive the digest
+class EDigest
+{
+public:
+    EDigest() : m_os(&m_buffer)
+#ifdef ECAD_BOOST_SERIALIZATION_SUPPORT
+    , m_oa(m_os, boost::archive::no_header)
+#endif//ECAD_BOOST_SERIALIZATION_SUPPORT
+    {
+    }
+
+    template <typename T, typename std::enable_if<std::is_arithmetic_v<T> || std::is_enum_v<T>, bool>::type = true>
+    EDigest & operator<< (const T & value)
+    {
+        m_os.write(reinterpret_cast<CPtr<char>>(&value), sizeof(T));
+        return *this;
+    }
+
+    EDigest & operator<< (const std::string & str)
+    {
+        *this << str.size();
+        m_os.write(str.data(), str.size());
+        return *this;
+    }
+
+    EDigest & operator<< (const EPoint2D & point)
+    {
+        return *this << point[0] << point[1];
+    }
+
+    EDigest & operator<< (const EPolygonData & polygon)
+    {
+        const auto & points = polygon.GetPoints();
+        *this << points.size();
+        for (const auto & point : points) *this << point;
+        return *this;
+    }
+
+    EDigest & operator<< (const EPolygonWithHolesData & pwh)
+    {
+        *this << pwh.outline << pwh.holes.size();
+        for (const auto & hole : pwh.holes) *this << hole;
+        return *this;
+    }
+
+    EDigest & operator<< (CPtr<EShape> shape)
+    {
+        if (nullptr == shape) return *this << false;
+        return *this << true << shape->GetPolygonWithHoles();
+    }
+
+    template <typename T>
+    EDigest & Archive(const T & object)
+    {
+#ifdef ECAD_BOOST_SERIALIZATION_SUPPORT
+        m_oa << object;
+#else
+        ECAD_UNUSED(object)
+#endif//ECAD_BOOST_SERIALIZATION_SUPPORT
+        return *this;
+    }
+
+    uint64_t Value()
+    {
+        m_os.flush();
+        return m_buffer.Value();
+    }
+
+private:
+    EDigestBuffer m_buffer;
+    std::ostream m_os;
+#ifdef ECAD_BOOST_SERIALIZATION_SUPPORT
+    boost::archive::binary_oarchive m_oa;
+#endif//ECAD_BOOST_SERIALIZATION_SUPPORT
+};
+
+ECAD_INLINE void DigestMaterial(EDigest & digest, CPtr<IMaterialDef> material)
+{
+    static constexpr std::array<EMaterialPropId, 12> propIds = {
+        EMaterialPropId::Permittivity, EMaterialPropId::Permeability, EMaterialPropId::Conductivity,
+        EMaterialPropId::DielectricLossTangent, EMaterialPropId::MagneticLossTangent, EMaterialPropId::Resistivity,
+        EMaterialPropId::ThermalConductivity, EMaterialPropId::MassDensity, EMaterialPropId::SpecificHeat,
+        EMaterialPropId::YoungsModulus, EMaterialPropId::PoissonsRatio, EMaterialPropId::ThermalExpansionCoefficient};
+
+    digest << material->GetName() << material->GetMaterialId() << material->GetMaterialType();
+    for (auto id : propIds) {
+        auto prop = material->GetProperty(id);
+        digest << id << (nullptr != prop);
+        if (prop) digest.Archive(prop);
+    }
+}
+
+ECAD_INLINE void DigestComponent(EDigest & digest, CPtr<IComponent> component)
+{
+    auto compDef = component->GetComponentDef();
+    digest << component->GetName() << component->GetPlacementLayer() << component->isFlipped() << component->GetHeight();
+    digest << compDef->GetName() << compDef->GetMaterial() << compDef->GetSolderFillingMaterial() << compDef->GetSolderBallBumpHeight();
+    digest << component->GetBoundary().get() << component->hasLossPower() << component->GetDynamicPowerScenario();
+    digest.Archive(component->GetTransform());
+    if (component->hasLossPower()) digest.Archive(component->GetLossPowerTable());
+}
+
+ECAD_INLINE void DigestPadstackDefData(EDigest & digest, CPtr<IPadstackDef> psDef)
+{
+    digest << (nullptr != psDef);
+    if (nullptr == psDef) return;
+    auto defData = psDef->GetPadstackDefData();
+    digest << psDef->GetName() << (nullptr != defData);
+    if (defData) digest.Archive(CPtr<IPadstackDefData>(defData));
+}
+
+ECAD_INLINE void DigestBondwire(EDigest & digest, CPtr<IBondwire> bondwire)
+{
+    auto digestEnd = [&digest](CPtr<IComponent> comp, const std::string & pin, ELayerId layer, bool flipped) {
+        digest << layer << flipped << pin << (nullptr != comp);
+        if (nullptr == comp) return;
+        EPoint2D loc;
+        digest << comp->GetName() << comp->GetPinLocation(pin, loc) << loc;
+    };
+    bool startFlipped{false}, endFlipped{false};
+    auto startLayer = bondwire->GetStartLayer(&startFlipped);
+    auto endLayer = bondwire->GetEndLayer(&endFlipped);
+    digest << bondwire->GetName() << bondwire->GetNet() << bondwire->GetRadius() << bondwire->GetHeight();
+    digest << bondwire->GetBondwireType() << bondwire->GetMaterial() << bondwire->GetCurrent() << bondwire->GetDynamicPowerScenario();
+    digest << bondwire->GetStartPt() << bondwire->GetEndPt();
+    digestEnd(bondwire->GetStartComponent(), bondwire->GetStartComponentPin(), startLayer, startFlipped);
+    digestEnd(bondwire->GetEndComponent(), bondwire->GetEndComponentPin(), endLayer, endFlipped);
+    DigestPadstackDefData(digest, bondwire->GetSolderJoints());
+}
+
+template <typename Settings>
+ECAD_INLINE uint64_t SettingsDigest(const Settings & settings)
+{
+    EDigest digest;
+    digest << toInt(CURRENT_VERSION);
+    digest.Archive(settings);
+    return digest.Value();
+}
+
+///@brief unique per save within this process and distinct from other processes sharing the cache dir
+ECAD_INLINE std::string TempFileSuffix()
+{
+    static std::atomic<uint64_t> counter{0};
+#ifdef _WIN32
+    auto pid = _getpid();
+#else
+    auto pid = ::getpid();
+#endif//_WIN32
+    return ".tmp" + std::to_string(pid) + "_" + std::to_string(counter.fetch_add(1));
+}
+
+} // namespace detail
+
+ECAD_INLINE uint64_t EModelCache::LayoutDigest(CPtr<ILayoutView> layout)
+{
+    ECAD_EFFICIENCY_TRACK("layout digest")
+    detail::EDigest digest;
+    digest << toInt(CURRENT_VERSION);
+
+    const auto & coordUnits = layout->GetDatabase()->GetCoordUnits();
+    digest << coordUnits.Scale2Unit() << coordUnits.toUnit(coordUnits.toCoord(1), ECoordUnits::Unit::Meter);
+    digest << layout->GetBoundary();
+
+    std::vector<CPtr<IStackupLayer> > stackupLayers;
+    layout->GetStackupLayers(stackupLayers);
+    digest << stackupLayers.size();
+    for (auto layer : stackupLayers) {
+        digest << layer->GetName() << layer->GetLayerId() << layer->GetLayerType() << layer->GetElevation() << layer->GetThickness();
+        digest << layer->GetConductingMaterial() << layer->GetDielectricMaterial();
+    }
+
+    //unordered collections are sorted by name so the digest does not depend on the hash table layout
+    std::vector<CPtr<IMaterialDef> > materials;
+    auto matIter = layout->GetDatabase()->GetMaterialDefIter();
+    while (auto material = matIter->Next()) materials.emplace_back(material);
+    std::sort(materials.begin(), materials.end(), [](auto m1, auto m2) { return m1->GetName() < m2->GetName(); });
+    digest << materials.size();
+    for (auto material : materials) detail::DigestMaterial(digest, material);
+
+    std::vector<CPtr<IComponent> > components;
+    auto compIter = layout->GetComponentIter();
+    while (auto component = compIter->Next()) components.emplace_back(component);
+    std::sort(components.begin(), components.end(), [](auto c1, auto c2) { return c1->GetName() < c2->GetName(); });
+    digest << components.size();
+    for (auto component : components) detail::DigestComponent(digest, component);
+
+    auto primitives = layout->GetPrimitiveCollection();
+    digest << primitives->Size();
+    for (size_t i = 0; i < primitives->Size(); ++i) {
+        auto prim = primitives->GetPrimitive(i);
+        digest << prim->GetPrimitiveType();
+        if (auto bondwire = prim->GetBondwireFromPrimitive(); bondwire)
+            detail::DigestBondwire(digest, bondwire);
+        else if (auto geom = prim->GetGeometry2DFromPrimitive(); geom)
+            digest << prim->GetNet() << prim->GetLayer() << CPtr<EShape>(geom->GetShape());
+    }
+
+    auto psInstIter = layout->GetPadstackInstIter();
+    while (auto psInst = psInstIter->Next()) {
+        ELayerId top, bot;
+        psInst->GetLayerRange(top, bot);
+        digest << psInst->GetNet() << top << bot;
+        detail::DigestPadstackDefData(digest, psInst->GetPadstackDef());
+        for (int i = std::min(top, bot); i <= std::max(top, bot); ++i)
+            digest << psInst->GetLayerShape(static_cast<ELayerId>(i)).get();
+    }
+    return digest.Value();
+}
+
+ECAD_INLINE uint64_t EModelCache::SettingsDigest(const ELayerCutModelExtractionSettings & settings)
+{
+    //output only options do not change the model
+    auto normalized = settings;
+    normalized.dumpSketchImg = false;
+    normalized.cacheDir.clear();
+    return detail::SettingsDigest(normalized);
+}
+
+ECAD_INLINE uint64_t EModelCache::SettingsDigest(const EThermalModelExtractionSettings & settings)
+{
+    auto normalized = settings.Clone();
+    normalized->forceRebuild = false;
+    normalized->threads = 1;
+    normalized->workDir.clear();
+    normalized->cacheDir.clear();
+    if (auto prism = dynamic_cast<Ptr<EPrismThermalModelExtractionSettings>>(normalized.get()); prism) {
+        prism->meshSettings.dumpMeshFile = false;
+        prism->polygonMergeSettings.threads = 1;
+        prism->polygonMergeSettings.outFile.clear();
+        prism->layerCutSettings.dumpSketchImg = false;
+        prism->layerCutSettings.cacheDir.clear();
+        return detail::SettingsDigest(*prism);
+    }
+    if (auto grid = dynamic_cast<Ptr<EGridThermalModelExtractionSettings>>(normalized.get()); grid) {
+        grid->dumpHotmaps = false;
+        grid->dumpDensityFile = false;
+        grid->dumpTemperatureFile = false;
+        grid->metalFractionMappingSettings.threads = 1;
+        grid->metalFractionMappingSettings.outFile.clear();
+        grid->metalFractionMappingSettings.polygonMergeSettings.threads = 1;
+        grid->metalFractionMappingSettings.polygonMergeSettings.outFile.clear();
+        return detail::SettingsDigest(*grid);
+    }
+    return 0;
+}
+
+ECAD_INLINE std::string EModelCache::CacheFile(const std::string & cacheDir, EModelType type, uint64_t layoutDigest, uint64_t settingsDigest)
+{
+    if (cacheDir.empty() || not isCacheable(type)) return std::string{};
+    std::stringstream ss;
+    ss << cacheDir << ECAD_SEPS << toString(type) << '_' << std::hex << std::setfill('0')
+       << std::setw(16) << layoutDigest << '_' << std::setw(16) << settingsDigest << ".bin";
+    return ss.str();
+}
+
+ECAD_INLINE UPtr<IModel> EModelCache::Load(const std::string & filename, CPtr<ILayoutView> layout)
+{
+#ifdef ECAD_BOOST_SERIALIZATION_SUPPORT
+    std::ifstream ifs(filename, std::ios::binary);
+    if (not ifs.is_open()) return nullptr;
+
+    UPtr<IModel> model;
+    try {
+        unsigned int version{0};
+        Ptr<IModel> ptr{nullptr};
+        boost::archive::binary_iarchive ia(ifs);
+        ia & boost::serialization::make_nvp("version", version);
+        if (version != toInt(CURRENT_VERSION)) return nullptr;
+        ia & boost::serialization::make_nvp("model", ptr);
+        model.reset(ptr);
+    }
+    catch (const std::exception & e) {
+        ECAD_TRACE("failed to load model cache %1%: %2%", filename, e.what());
+        return nullptr;
+    }
+    if (auto prism = dynamic_cast<Ptr<model::EPrismThermalModel>>(model.get()); prism)
+        prism->SetLayoutView(layout);
+    return model;
+#else
+    ECAD_UNUSED(filename)
+    ECAD_UNUSED(layout)
+    return nullptr;
+#endif//ECAD_BOOST_SERIALIZATION_SUPPORT
+}
+
+ECAD_INLINE bool EModelCache::Save(const std::string & filename, Ptr<IModel> model)
+{
+#ifdef ECAD_BOOST_SERIALIZATION_SUPPORT
+    if (nullptr == model || not isCacheable(model->GetModelType())) return false;
+    if (not generic::fs::CreateDir(generic::fs::DirName(filename))) return false;
+
+    //the layout is owned by the database, the entry only keeps the model data and is re-linked on load
+    auto prism = dynamic_cast<Ptr<model::EPrismThermalModel>>(model);
+    auto layout = prism ? prism->GetLayoutView() : nullptr;
+    if (prism) prism->SetLayoutView(nullptr);
+
+    //written aside and renamed so concurrent readers never see a partial entry
+    auto tmpFile = filename + detail::TempFileSuffix();
+    bool res = false;
+    {
+        std::ofstream ofs(tmpFile, std::ios::binary);
+        if (ofs.is_open()) {
+            unsigned int version = toInt(CURRENT_VERSION);
+            boost::archive::binary_oarchive oa(ofs);
+            oa & boost::serialization::make_nvp("version", version);
+            oa & boost::serialization::make_nvp("model", model);
+            res = ofs.good();
+        }
+    }
+    if (prism) prism->SetLayoutView(layout);
+    if (res) res = 0 == std::rename(tmpFile.c_str(), filename.c_str());
+    if (not res) std::remove(tmpFile.c_str());
+    return res;
+#else
+    ECAD_UNUSED(filename)
+    ECAD_UNUSED(model)
+    return false;
+#endif//ECAD_BOOST_SERIALIZATION_SUPPORT
+}
+
+ECAD_INLINE bool EModelCache::isCacheable(EModelType type)
+{
+#ifdef ECAD_BOOST_SERIALIZATION_SUPPORT
+    //grid thermal model has no archive support yet
+    return EModelType::LayerCut == type || EModelType::ThermalPrism == type || EModelType::ThermalStackupPrism == type;
+#else
+    ECAD_UNUSED(type)
+    return false;
+#endif//ECAD_BOOST_SERIALIZATION_SUPPORT
+}
+
+}//namespace utils
+}//namespace ecad
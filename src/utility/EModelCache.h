@@ -0,0 +1,30 @@
+#pragma once
+#include "basic/ECadSettings.h"
+namespace ecad {
+
+class IModel;
+class ILayoutView;
+namespace utils {
+
+///@brief on-disk cache of extracted models, an entry is selected by a digest of the layout content the extraction reads
+///       and of the extraction settings that change the result, entries are written as binary archives
+class ECAD_API EModelCache
+{
+public:
+    ///@brief digest of stackup, materials, boundary, components, primitives and padstack instances, independent of object uuids
+    static uint64_t LayoutDigest(CPtr<ILayoutView> layout);
+    static uint64_t SettingsDigest(const ELayerCutModelExtractionSettings & settings);
+    static uint64_t SettingsDigest(const EThermalModelExtractionSettings & settings);
+
+    ///@brief returns empty if the model type has no archive support
+    static std::string CacheFile(const std::string & cacheDir, EModelType type, uint64_t layoutDigest, uint64_t settingsDigest);
+
+    ///@brief returns nullptr if the entry does not exist or can not be read, loaded thermal models refer to the given layout
+    static UPtr<IModel> Load(const std::string & filename, CPtr<ILayoutView> layout);
+    static bool Save(const std::string & filename, Ptr<IModel> model);
+
+    static bool isCacheable(EModelType type);
+};
+
+}//namespace utils
+}//namespace ecad
@@ -3,8 +3,13 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
 #include "extension/ECadExtension.h"
+#include "extension/gds/EGdsFileIO.h"
+#include "extension/kicad/EKiCadParser.h"
 #include "TestData.hpp"
 #include "EDataMgr.h"
+#include <filesystem>
+#include <fstream>
+#include <cmath>
 using namespace boost::unit_test;
 using namespace ecad;
 
@@ -44,6 +49,89 @@ void t_extension_gds()
     EDataMgr::Instance().ShutDown();
 }
 
+void t_extension_gds_synthetic()
+{
+    //synthetic library with one cell of a few boundaries and non-default units, read throughput is measured by ecad_bench
+    auto record = [](std::string & out, uint8_t type, uint8_t dataType, const std::string & payload = {}) {
+        auto size = 4 + payload.size();
+        out.push_back(char(size >> 8)); out.push_back(char(size & 0xff));
+        out.push_back(char(type)); out.push_back(char(dataType));
+        out.append(payload);
+    };
+    auto int2 = [](int v) { return std::string{char((v >> 8) & 0xff), char(v & 0xff)}; };
+    auto int4 = [](int v) { return std::string{char((v >> 24) & 0xff), char((v >> 16) & 0xff), char((v >> 8) & 0xff), char(v & 0xff)}; };
+    auto real8 = [](double v) {//excess-64 base-16
+        int e = 64;
+        while (v >= 1) { v /= 16; ++e; }
+        while (v < 1.0 / 16) { v *= 16; --e; }
+        auto m = static_cast<uint64_t>(std::ldexp(v, 56));
+        std::string s(1, char(e));
+        for (int i = 6; i >= 0; --i) s.push_back(char((m >> (8 * i)) & 0xff));
+        return s;
+    };
+
+    const int boundaries = 16;
+    const double unit = 2.5e-4, precision = 2.5e-10;
+    std::string gds;
+    std::string date; for (int i = 0; i < 12; ++i) date += int2(i < 6 ? 1 : 0);
+    record(gds, ext::gds::EGdsRecords::HEADER, 0x02, int2(600));
+    record(gds, ext::gds::EGdsRecords::BGNLIB, 0x02, date);
+    record(gds, ext::gds::EGdsRecords::LIBNAME, 0x06, std::string("SYNTH\0", 6));
+    record(gds, ext::gds::EGdsRecords::UNITS, 0x05, real8(unit) + real8(precision));
+    record(gds, ext::gds::EGdsRecords::BGNSTR, 0x02, date);
+    record(gds, ext::gds::EGdsRecords::STRNAME, 0x06, std::string("TOP\0", 4));
+    for (int i = 0; i < boundaries; ++i) {
+        int x = i * 10, y = -i * 3;
+        record(gds, ext::gds::EGdsRecords::BOUNDARY, 0x00);
+        record(gds, ext::gds::EGdsRecords::LAYER, 0x02, int2(i % 4));
+        record(gds, ext::gds::EGdsRecords::DATATYPE, 0x02, int2(0));
+        record(gds, ext::gds::EGdsRecords::XY, 0x03, int4(x) + int4(y) + int4(x + 100) + int4(y) + int4(x + 100) + int4(y + 50) + int4(x) + int4(y + 50) + int4(x) + int4(y));
+        record(gds, ext::gds::EGdsRecords::ENDEL, 0x00);
+    }
+    record(gds, ext::gds::EGdsRecords::ENDSTR, 0x00);
+    record(gds, ext::gds::EGdsRecords::ENDLIB, 0x00);
+    gds.append(2048 - gds.size() % 2048, '\0');
+
+    auto filename = (std::filesystem::temp_directory_path() / "ecad_synthetic.gds").string();
+    { std::ofstream out(filename, std::ios::binary); out.write(gds.data(), gds.size()); }
+
+    ext::gds::EGdsDB db;
+    ext::gds::EGdsReader reader(db);
+    BOOST_CHECK(reader(filename));
+    std::filesystem::remove(filename);
+
+    BOOST_REQUIRE(db.Cells().size() == 1);
+    BOOST_CHECK(db.Cells().front().objects.size() == size_t(boundaries));
+    BOOST_CHECK(db.Layers().size() == 4);
+    BOOST_CHECK(db.libName == "SYNTH");
+
+    //REAL_8 decode
+    BOOST_CHECK_CLOSE(db.coordUnits.Scale2Unit(), unit, 1e-9);
+    BOOST_CHECK_CLOSE(db.coordUnits.toCoordF(1, ECoordUnits::Unit::Micrometer), 1e-6 / precision, 1e-9);
+}
+
+void t_extension_kicad_parser()
+{
+    using namespace ext::kicad;
+    const std::string_view text = "(kicad_pcb (net 1 \"GND\") (layers (0 \"F.Cu\" signal)) (net 2 \"GND\"))";
+    Tree tree;
+    EKiCadParser parser;
+    BOOST_REQUIRE(parser(text.data(), text.size(), tree));
+    BOOST_CHECK(tree.value == "kicad_pcb");
+    BOOST_REQUIRE(tree.branches.size() == 3);
+    BOOST_CHECK(tree.branches[1].branches.front().branches.at(0).value == "F.Cu");
+    //atoms are interned
+    BOOST_CHECK(tree.branches[0].value.data() == tree.branches[2].value.data());
+    BOOST_CHECK(tree.branches[0].branches[1].value.data() == tree.branches[2].branches[1].value.data());
+    BOOST_CHECK(parser.TotalNodes() == 11);
+
+    std::string kicad = ecad_test::GetTestDataPath() + "/kicad/test.kicad_pcb";
+    BOOST_REQUIRE(parser(kicad, tree));
+    BOOST_CHECK(tree.value == "kicad_pcb");
+    BOOST_CHECK(tree.branches.size() > 0);
+    BOOST_CHECK(parser.TotalAtoms() < parser.TotalNodes());
+}
+
 void t_extension_xfl()
 {
     std::string err;
@@ -65,6 +153,8 @@ test_suite * create_ecad_extension_test_suite()
     //
     extension_suite->add(BOOST_TEST_CASE(&t_extension_dmcdom));
     extension_suite->add(BOOST_TEST_CASE(&t_extension_gds));
+    extension_suite->add(BOOST_TEST_CASE(&t_extension_gds_synthetic));
+    extension_suite->add(BOOST_TEST_CASE(&t_extension_kicad_parser));
     extension_suite->add(BOOST_TEST_CASE(&t_extension_xfl));
     //
     return extension_suite;
@@ -3,6 +3,14 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
 #include "generic/tools/StringHelper.hpp"
+#include "generic/tools/FileSystem.hpp"
+#include "solver/thermal/utils/EPrismThermalNetworkBuilder.h"
+#include "solver/thermal/utils/EGridThermalNetworkBuilder.h"
+#include "model/thermal/io/EThermalModelIO.h"
+#include "model/thermal/utils/EPrismThermalModelQuery.h"
+#include "model/thermal/EPrismThermalModel.h"
+#include "generic/thread/ThreadPool.hpp"
+#include "utility/EModelCache.h"
 #include "TestData.hpp"
 #include "EDataMgr.h"
 using namespace boost::unit_test;
@@ -359,12 +367,244 @@ void t_thermal_static_flow2()
     EDataMgr::Instance().ShutDown();
 }
 
+namespace ecad_test {
+///@brief 20x20mm copper board with a powered 4x4mm die in the center, the fixture of the prism thermal flow tests
+inline Ptr<ILayoutView> CreateSingleDieLayout(const std::string & name, EScenarioId scenario = invalidIndex)
+{
+    auto & eDataMgr = EDataMgr::Instance();
+    auto database = eDataMgr.CreateDatabase(name);
+    if (nullptr == database) return nullptr;
+    auto matCu = database->CreateMaterialDef("Cu");
+    matCu->SetProperty(EMaterialPropId::ThermalConductivity, eDataMgr.CreateSimpleMaterialProp(398));
+    matCu->SetProperty(EMaterialPropId::SpecificHeat, eDataMgr.CreateSimpleMaterialProp(380));
+    matCu->SetProperty(EMaterialPropId::MassDensity, eDataMgr.CreateSimpleMaterialProp(8850));
+
+    ECoordUnits coordUnits(ECoordUnits::Unit::Micrometer);
+    database->SetCoordUnits(coordUnits);
+
+    auto topCell = eDataMgr.CreateCircuitCell(database, "TopCell");
+    auto topLayout = topCell->GetLayoutView();
+    topLayout->SetBoundary(std::make_unique<EPolygon>(eDataMgr.CreatePolygon(coordUnits, {{-10000, -10000}, {10000, -10000}, {10000, 10000}, {-10000, 10000}})));
+    auto iLyrTopCu = topLayout->AppendLayer(eDataMgr.CreateStackupLayer("TopCu", ELayerType::ConductingLayer, 0, 400, matCu->GetName(), matCu->GetName()));
+    if (ELayerId::noLayer == iLyrTopCu) return nullptr;
+
+    auto compDef = eDataMgr.CreateComponentDef(database, "Die");
+    compDef->SetBoundary(eDataMgr.CreateShapeRectangle(coordUnits, FPoint2D(-2000, -2000), FPoint2D(2000, 2000)));
+    compDef->SetMaterial(matCu->GetName());
+    compDef->SetHeight(365);
+    compDef->SetSolderFillingMaterial(matCu->GetName());
+    auto comp = eDataMgr.CreateComponent(topLayout, "M1", compDef, iLyrTopCu, makeETransform2D(1, 0, EVector2D(0, 0)), false);
+    if (nullptr == comp) return nullptr;
+    comp->SetLossPower(ETemperature::Celsius2Kelvins(25), 10);
+    comp->SetDynamicPowerScenario(scenario);
+
+    database->Flatten(topCell, 1);
+    return topCell->GetFlattenedLayoutView();
+}
+
+inline EPrismThermalModelExtractionSettings SingleDiePrismSettings(EFloat maxLen)
+{
+    EPrismThermalModelExtractionSettings prismSettings(ecad_test::GetTestDataPath() + "/simulation/thermal", 4, {});
+    prismSettings.meshSettings.iteration = 1e5;
+    prismSettings.meshSettings.maxLen = maxLen;
+    prismSettings.botUniformBC = EThermalBoundaryCondition(2750, EThermalBoundaryConditionType::HTC);
+    return prismSettings;
+}
+
+///@brief node data and adjacency of both networks are identical
+template <typename Network>
+inline void CheckSameNetwork(const Network & lhs, const Network & rhs)
+{
+    BOOST_REQUIRE(lhs.Size() == rhs.Size());
+    BOOST_REQUIRE(lhs.TotalEdges() == rhs.TotalEdges());
+    for (size_t i = 0; i < lhs.Size(); ++i) {
+        BOOST_CHECK(lhs.GetScenario(i) == rhs.GetScenario(i));
+        BOOST_CHECK(lhs.GetHF(i) == rhs.GetHF(i));
+        BOOST_CHECK(lhs.GetHTC(i) == rhs.GetHTC(i));
+        BOOST_CHECK(lhs.GetC(i) == rhs.GetC(i));
+        std::vector<std::pair<size_t, EFloat> > lEdges, rEdges;
+        lhs.ForEachR(i, [&](size_t j, EFloat r) { lEdges.emplace_back(j, r); });
+        rhs.ForEachR(i, [&](size_t j, EFloat r) { rEdges.emplace_back(j, r); });
+        BOOST_CHECK(lEdges == rEdges);
+    }
+}
+}//namespace ecad_test
+
+void t_thermal_network_parallel_build()
+{
+    EDataMgr::Instance().Init();
+    auto layout = ecad_test::CreateSingleDieLayout("ParallelBuild"); BOOST_REQUIRE(layout);
+    auto prismModel = dynamic_cast<CPtr<model::EPrismThermalModel>>(layout->ExtractThermalModel(ecad_test::SingleDiePrismSettings(200)));
+    BOOST_REQUIRE(prismModel);
+
+    using Builder = solver::EPrismThermalNetworkBuilder<EFloat>;
+    BOOST_CHECK(prismModel->TotalPrismElements() > Builder::prismChunkSize);
+
+    //run with -DENABLE_TSAN=ON to check the multi-threaded assembly for data races
+    std::vector<EFloat> iniT(prismModel->TotalElements(), ETemperature::Celsius2Kelvins(25));
+    Builder builder(*prismModel);
+    auto serial = builder.Build(iniT, 1); BOOST_REQUIRE(serial);
+    auto summary = builder.summary;
+    for (size_t threads : {2, 4, 8}) {
+        auto parallel = builder.Build(iniT, threads); BOOST_REQUIRE(parallel);
+        ecad_test::CheckSameNetwork(*serial, *parallel);
+        BOOST_CHECK(summary.boundaryNodes == builder.summary.boundaryNodes);
+        BOOST_CHECK(summary.iHeatFlow == builder.summary.iHeatFlow);
+        BOOST_CHECK(summary.oHeatFlow == builder.summary.oHeatFlow);
+    }
+    EDataMgr::Instance().ShutDown();
+}
+
+void t_thermal_network_update()
+{
+    EDataMgr::Instance().Init();
+    auto layout = ecad_test::CreateSingleDieLayout("NetworkUpdate"); BOOST_REQUIRE(layout);
+    auto prismModel = dynamic_cast<CPtr<model::EPrismThermalModel>>(layout->ExtractThermalModel(ecad_test::SingleDiePrismSettings(200)));
+    BOOST_REQUIRE(prismModel);
+
+    //in place update keeps the adjacency and matches a fresh build at the same temperatures
+    using Builder = solver::EPrismThermalNetworkBuilder<EFloat>;
+    std::vector<EFloat> iniT(prismModel->TotalElements(), ETemperature::Celsius2Kelvins(25));
+    Builder builder(*prismModel);
+    auto network = builder.Build(iniT, 1); BOOST_REQUIRE(network);
+    for (size_t i = 0; i < iniT.size(); ++i)
+        iniT[i] += i % 7;
+    auto rebuilt = builder.Build(iniT, 1); BOOST_REQUIRE(rebuilt);
+    BOOST_CHECK(builder.Update(iniT, *network, 4));
+    ecad_test::CheckSameNetwork(*rebuilt, *network);
+    EDataMgr::Instance().ShutDown();
+}
+
+void t_grid_thermal_network_update()
+{
+    std::string err;
+    EDataMgr::Instance().Init();
+    auto gridModel = model::io::makeGridThermalModelFromCTMv1File(ecad_test::GetTestDataPath() + "/ctm/test.tar.gz", 0, &err);
+    BOOST_REQUIRE(gridModel);
+    gridModel->SetUniformBC(EOrientation::Top, EThermalBoundaryCondition(200000, EThermalBoundaryConditionType::HTC));
+    gridModel->SetUniformBC(EOrientation::Bot, EThermalBoundaryCondition(200000, EThermalBoundaryConditionType::HTC));
+
+    //in place update keeps the adjacency and the block power nodes, same as a fresh build at the same temperatures
+    using Builder = solver::EGridThermalNetworkBuilder<EFloat>;
+    std::vector<EFloat> iniT(gridModel->TotalGrids(), ETemperature::Celsius2Kelvins(25));
+    Builder builder(*gridModel);
+    auto network = builder.Build(iniT); BOOST_REQUIRE(network);
+    for (size_t i = 0; i < iniT.size(); ++i)
+        iniT[i] += i % 7;
+    auto rebuilt = builder.Build(iniT); BOOST_REQUIRE(rebuilt);
+    BOOST_CHECK(builder.Update(iniT, *network));
+    ecad_test::CheckSameNetwork(*rebuilt, *network);
+
+    //slots that are not set again after a reset are no edges
+    network->ResetValues();
+    size_t edges{0};
+    for (size_t i = 0; i < network->Size(); ++i)
+        network->ForEachR(i, [&](size_t, EFloat) { edges++; });
+    BOOST_CHECK(0 == edges);
+    EDataMgr::Instance().ShutDown();
+}
+
+void t_prism_model_concurrent_query()
+{
+    EDataMgr::Instance().Init();
+    auto layout = ecad_test::CreateSingleDieLayout("ConcurrentQuery"); BOOST_REQUIRE(layout);
+    auto prismModel = dynamic_cast<CPtr<model::EPrismThermalModel>>(layout->ExtractThermalModel(ecad_test::SingleDiePrismSettings(500)));
+    BOOST_REQUIRE(prismModel);
+
+    //layer trees built concurrently on first use answer the same as trees built one by one
+    using Query = model::utils::EPrismThermalModelQuery;
+    Query serialQuery(prismModel), concurrentQuery(prismModel);
+    const size_t repeats = 4, layers = prismModel->TotalLayers();
+    std::vector<std::vector<Query::RtVal> > expected(layers), results(layers * repeats);
+    for (size_t layer = 0; layer < layers; ++layer)
+        serialQuery.SearchNearestPrismInstances(layer, EPoint2D(0, 0), 3, expected[layer]);
+    {
+        generic::thread::ThreadPool pool(4);
+        for (size_t i = 0; i < results.size(); ++i)
+            pool.Submit([&, i] { concurrentQuery.SearchNearestPrismInstances(i % layers, EPoint2D(0, 0), 3, results[i]); });
+    }
+    for (size_t i = 0; i < results.size(); ++i)
+        BOOST_CHECK(results.at(i) == expected.at(i % layers));
+    EDataMgr::Instance().ShutDown();
+}
+
+void t_thermal_static_sweep()
+{
+    EDataMgr::Instance().Init();
+    auto layout = ecad_test::CreateSingleDieLayout("StaticSweep", 1); BOOST_REQUIRE(layout);
+
+    EThermalStaticSimulationSetup setup(ecad_test::GetTestDataPath() + "/simulation/thermal", 4, {});
+    setup.settings.iteration = 1;
+    setup.settings.dumpResults = false;
+    setup.settings.solverType = EThermalNetworkStaticSolverType::LLT;
+    setup.monitors.emplace_back(0, 0, 0);
+    setup.extractionSettings = std::make_unique<EPrismThermalModelExtractionSettings>(ecad_test::SingleDiePrismSettings(500));
+    std::vector<EFloat> temperatures;
+    auto [minT, maxT] = layout->RunThermalSimulation(setup, temperatures);
+
+    //constant materials, so every case is an exact linear variation of the reference
+    std::vector<EThermalStaticSweepCase> cases(4);
+    cases[1].powerScales.emplace(1, 2);
+    cases[2].envTemperature = {35, ETemperatureUnit::Celsius};
+    cases[3].htcScale = 2;
+    std::vector<std::vector<EFloat> > sweepTemperatures;
+    auto ranges = layout->RunThermalSweep(setup, cases, sweepTemperatures);
+    BOOST_REQUIRE(ranges.size() == cases.size());
+    BOOST_REQUIRE(sweepTemperatures.size() == cases.size());
+    BOOST_CHECK_CLOSE(ranges[0].first, minT, 1e-2);
+    BOOST_CHECK_CLOSE(ranges[0].second, maxT, 1e-2);
+    BOOST_CHECK_CLOSE(sweepTemperatures[0].front(), temperatures.front(), 1e-2);
+    BOOST_CHECK_CLOSE(ranges[1].second - 25, 2 * (maxT - 25), 1e-1);
+    BOOST_CHECK_CLOSE(ranges[2].second, maxT + 10, 1e-2);
+    BOOST_CHECK(ranges[3].second < maxT);
+    EDataMgr::Instance().ShutDown();
+}
+
+void t_thermal_model_cache()
+{
+    if (not utils::EModelCache::isCacheable(EModelType::ThermalPrism)) return;
+
+    EDataMgr::Instance().Init();
+    //two databases with identical content but different object uuids
+    auto layout1 = ecad_test::CreateSingleDieLayout("ModelCache1"); BOOST_REQUIRE(layout1);
+    auto layout2 = ecad_test::CreateSingleDieLayout("ModelCache2"); BOOST_REQUIRE(layout2);
+    BOOST_CHECK(utils::EModelCache::LayoutDigest(layout1) == utils::EModelCache::LayoutDigest(layout2));
+
+    auto prismSettings = ecad_test::SingleDiePrismSettings(500);
+    prismSettings.layerCutSettings.dumpSketchImg = false;
+    prismSettings.cacheDir = prismSettings.workDir + "/cache";
+    auto cacheFile = utils::EModelCache::CacheFile(prismSettings.cacheDir, EModelType::ThermalPrism,
+        utils::EModelCache::LayoutDigest(layout1), utils::EModelCache::SettingsDigest(prismSettings));
+    std::remove(cacheFile.c_str());
+
+    auto model1 = dynamic_cast<CPtr<model::EPrismThermalModel>>(layout1->ExtractThermalModel(prismSettings));
+    BOOST_REQUIRE(model1);
+    BOOST_CHECK(generic::fs::FileExists(cacheFile));
+
+    //execution only options do not change the entry
+    prismSettings.threads = 1;
+    auto model2 = dynamic_cast<CPtr<model::EPrismThermalModel>>(layout2->ExtractThermalModel(prismSettings));
+    BOOST_REQUIRE(model2);
+    BOOST_CHECK(model2->GetLayoutView() == layout2);
+    BOOST_CHECK(nullptr == layout2->GetModelCollection()->FindModel(EModelType::LayerCut));
+    BOOST_CHECK(model1->TotalElements() == model2->TotalElements());
+    BOOST_CHECK(model1->GetPoints().size() == model2->GetPoints().size());
+    std::remove(cacheFile.c_str());
+    EDataMgr::Instance().ShutDown();
+}
+
 test_suite * create_ecad_flow_test_suite()
 {
     test_suite * simulation_suite = BOOST_TEST_SUITE("s_flow_test");
     //
     simulation_suite->add(BOOST_TEST_CASE(&t_thermal_static_flow1));
     simulation_suite->add(BOOST_TEST_CASE(&t_thermal_static_flow2));
+    simulation_suite->add(BOOST_TEST_CASE(&t_thermal_network_parallel_build));
+    simulation_suite->add(BOOST_TEST_CASE(&t_thermal_network_update));
+    simulation_suite->add(BOOST_TEST_CASE(&t_grid_thermal_network_update));
+    simulation_suite->add(BOOST_TEST_CASE(&t_prism_model_concurrent_query));
+    simulation_suite->add(BOOST_TEST_CASE(&t_thermal_static_sweep));
+    simulation_suite->add(BOOST_TEST_CASE(&t_thermal_model_cache));
     //
     return simulation_suite;
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
 #include "EDataMgr.h"
+#include "basic/ELookupTable.h"
 
 using namespace boost::unit_test;
 using namespace ecad;
@@ -92,6 +93,31 @@ void t_class_primitive()
     mgr.ShutDown();   
 }
 
+void t_class_lookup_table()
+{
+    ELookupTable1D table;
+    BOOST_CHECK(table.Lookup(300) == 0);
+    table.AddSample(400, 30);
+    BOOST_CHECK(table.Lookup(300) == 30);
+    table.AddSample(300, 10);
+    table.AddSample(350, 20);
+    table.AddSample(350, 0);//ignored, already sampled
+    BOOST_CHECK(table.Size() == 3);
+    BOOST_CHECK(std::is_sorted(table.Keys().begin(), table.Keys().end()));
+
+    BOOST_CHECK_CLOSE(table.Lookup(200), 10, 1e-10);
+    BOOST_CHECK_CLOSE(table.Lookup(325), 15, 1e-10);
+    BOOST_CHECK_CLOSE(table.Lookup(350), 20, 1e-10);
+    BOOST_CHECK_CLOSE(table.Lookup(380), 26, 1e-10);
+    BOOST_CHECK_CLOSE(table.Lookup(500), 30, 1e-10);
+
+    std::vector<float> keys{250, 310, 349.5f, 399, 420};
+    std::vector<double> values(keys.size());
+    table.Lookup(keys.data(), values.data(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+        BOOST_CHECK_CLOSE(values.at(i), table.Lookup(keys.at(i)), 1e-10);
+}
+
 test_suite * create_ecad_function_test_suite()
 {
     test_suite * function_suite = BOOST_TEST_SUITE("s_function_test");
@@ -100,6 +126,7 @@ test_suite * create_ecad_function_test_suite()
     function_suite->add(BOOST_TEST_CASE(&t_class_cell));
     function_suite->add(BOOST_TEST_CASE(&t_class_layer_collection));
     function_suite->add(BOOST_TEST_CASE(&t_class_primitive));
+    function_suite->add(BOOST_TEST_CASE(&t_class_lookup_table));
     //
     return function_suite;
 }
\ No newline at end of file
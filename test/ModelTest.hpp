@@ -3,8 +3,16 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
 #include "generic/tools/FileSystem.hpp"
+#include "model/thermal/utils/EStackupPrismThermalModelBuilder.h"
 #include "model/thermal/io/EChipThermalModelIO.h"
+#include "model/thermal/io/EVTUWriter.h"
 #include "TestData.hpp"
+#ifdef ECAD_ZLIB_SUPPORT
+#include <zlib.h>
+#endif//ECAD_ZLIB_SUPPORT
+#include <filesystem>
+#include <cstring>
+#include <map>
 using namespace boost::unit_test;
 using namespace ecad;
 using namespace ecad::model;
@@ -14,10 +22,11 @@ void s_ctm_model_io_test()
     std::string ctm = ecad_test::GetTestDataPath() + "/ctm/test.tar.gz";
     std::string ctmFolder = ecad_test::GetTestDataPath() + "/ctm/test";
     auto model = io::makeChipThermalModelFromCTMv1File(ctm, &err);
-    BOOST_CHECK(generic::fs::PathExists(ctmFolder));
-    generic::fs::RemoveDir(ctmFolder);
+    BOOST_CHECK(not generic::fs::PathExists(ctmFolder));//read in process, nothing staged next to the archive
     BOOST_CHECK(err.empty());
-    BOOST_CHECK(model);
+    BOOST_REQUIRE(model);
+    BOOST_CHECK(model->header.temperatures.size() == model->powers->GetTable().GetSampleSize());
+    BOOST_CHECK(model->header.layers.size() == model->densities.size());
 
     std::string outFile = "test";
     std::string outFolder = ecad_test::GetTestDataPath() + "/ctm/out";
@@ -25,11 +34,144 @@ void s_ctm_model_io_test()
     BOOST_CHECK(res);
 }
 
+void s_ctm_binary_io_test()
+{
+    //more tiles than one transpose block with a partial tail, read throughput is measured by ecad_bench
+    using namespace io::detail;
+    const size_t nx = 70, ny = 65, layers = 3;
+    EGridData powers(nx, ny);
+    std::vector<SPtr<EGridData> > density;
+    for (size_t i = 0; i < layers; ++i)
+        density.push_back(std::make_shared<EGridData>(nx, ny));
+    for (size_t i = 0; i < powers.Size(); ++i) {
+        powers[i] = 0.25 * (i % 4096);
+        for (size_t j = 0; j < layers; ++j)
+            (*density[j])[i] = 1.0 / (1 << (i + j) % 16);
+    }
+
+    auto dir = std::filesystem::temp_directory_path();
+    auto powerFile = (dir / "ecad_synthetic_power.ctm").string();
+    auto densityFile = (dir / "ecad_synthetic_density.ctm").string();
+    BOOST_REQUIRE(WriteCTMv1PowerFile(powerFile, powers));
+    BOOST_REQUIRE(WriteCTMv1DensityFile(densityFile, powers.Size(), 1, FPoint2D(0, 0), density));
+
+    EGridData powersIn(nx, ny);
+    BOOST_CHECK(ParseCTMv1PowerFile(powerFile, powersIn));
+    std::vector<SPtr<EGridData> > densityIn;
+    for (size_t i = 0; i < layers; ++i)
+        densityIn.push_back(std::make_shared<EGridData>(nx, ny));
+    BOOST_CHECK(ParseCTMv1DensityFile(densityFile, powers.Size(), densityIn));
+
+    //all values are exact in float
+    size_t mismatch = 0;
+    for (size_t i = 0; i < powers.Size(); ++i) {
+        if (powers[i] != powersIn[i]) mismatch++;
+        for (size_t j = 0; j < layers; ++j)
+            if ((*density[j])[i] != (*densityIn[j])[i]) mismatch++;
+    }
+    BOOST_CHECK(0 == mismatch);
+    std::filesystem::remove(powerFile);
+    std::filesystem::remove(densityFile);
+}
+
+namespace ecad_test {
+///@brief raw bytes of each appended data array of a .vtu file written by EVTUWriter, by array name
+inline std::map<std::string, std::vector<char> > ReadVTUArrays(const std::string & filename)
+{
+    std::ifstream in(filename, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::map<std::string, std::vector<char> > arrays;
+    const auto data = content.find('_', content.find("<AppendedData")) + 1;
+    const bool compressed = content.find("vtkZLibDataCompressor") < data;
+    auto attribute = [&](size_t pos, const std::string & key) {
+        auto begin = content.find(key + "=\"", pos) + key.size() + 2;
+        return content.substr(begin, content.find('"', begin) - begin);
+    };
+    for (auto pos = content.find("<DataArray"); pos < data; pos = content.find("<DataArray", pos + 1)) {
+        auto & bytes = arrays[attribute(pos, "Name")];
+        const char * p = content.data() + data + std::stoull(attribute(pos, "offset"));
+        uint64_t header[3]{0, 0, 0};
+        if (not compressed) {
+            std::memcpy(header, p, sizeof(uint64_t));
+            bytes.assign(p + sizeof(uint64_t), p + sizeof(uint64_t) + header[0]);
+            continue;
+        }
+#ifdef ECAD_ZLIB_SUPPORT
+        std::memcpy(header, p, sizeof(header));
+        std::vector<uint64_t> sizes(header[0]);
+        std::memcpy(sizes.data(), p + sizeof(header), sizes.size() * sizeof(uint64_t));
+        p += sizeof(header) + sizes.size() * sizeof(uint64_t);
+        for (size_t b = 0; b < sizes.size(); ++b) {
+            uLongf length = b + 1 == sizes.size() && header[2] ? header[2] : header[1];
+            std::vector<char> block(length);
+            uncompress(reinterpret_cast<Bytef *>(block.data()), &length, reinterpret_cast<const Bytef *>(p), sizes[b]);
+            bytes.insert(bytes.end(), block.begin(), block.begin() + length);
+            p += sizes[b];
+        }
+#endif//ECAD_ZLIB_SUPPORT
+    }
+    return arrays;
+}
+}//namespace ecad_test
+
+void s_vtu_writer_test()
+{
+    using namespace ecad::model::io;
+    //one wedge and one line, the arrays parsed back must equal the written ones in both encodings
+    const std::vector<Float64> points{0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 2, 2, 0, 2, 2, 1};
+    const std::vector<Int64> connects{0, 1, 2, 3, 4, 5, 6, 7}, offsets{6, 8};
+    const std::vector<uint8_t> types{EVTUWriter::Wedge, EVTUWriter::Line};
+    const std::vector<Float32> temperature{25.5f, 80.25f};
+    const std::vector<Float64> times{0.5};
+    auto bytes = [](const auto & values) {
+        auto begin = reinterpret_cast<const char *>(values.data());
+        return std::vector<char>(begin, begin + values.size() * sizeof(values.front()));
+    };
+    auto filename = (std::filesystem::temp_directory_path() / "ecad_vtu_test.vtu").string();
+    for (bool compress : {false, true}) {
+        if (compress && not EVTUWriter::CompressionSupported()) continue;
+        EVTUWriter writer(points.size() / 3, types.size(), compress);
+        writer.SetPoints(EVTUWriter::makeFiller(points));
+        writer.SetCells(connects.size(), EVTUWriter::makeFiller(connects), EVTUWriter::makeFiller(offsets), EVTUWriter::makeFiller(types));
+        writer.AddCellData("temperature", std::vector<Float32>(temperature));//owned by the writer
+        writer.AddFieldData("TimeValue", times);
+        std::string err;
+        BOOST_REQUIRE(writer.Write(filename, &err));
+
+        auto arrays = ecad_test::ReadVTUArrays(filename);
+        BOOST_CHECK(arrays.size() == 6);
+        BOOST_CHECK(arrays["Points"] == bytes(points));
+        BOOST_CHECK(arrays["connectivity"] == bytes(connects));
+        BOOST_CHECK(arrays["offsets"] == bytes(offsets));
+        BOOST_CHECK(arrays["types"] == bytes(types));
+        BOOST_CHECK(arrays["temperature"] == bytes(temperature));
+        BOOST_CHECK(arrays["TimeValue"] == bytes(times));
+    }
+    std::filesystem::remove(filename);
+}
+
+void s_triangle_intersect_area_test()
+{
+    using Builder = utils::EStackupPrismThermalModelBuilder;
+    auto triangle = [](EPoint2D p0, EPoint2D p1, EPoint2D p2) { return ETriangle2D(p0, p1, p2); };
+    auto t = triangle({0, 0}, {10, 0}, {0, 10});
+    BOOST_CHECK_CLOSE(Builder::GetIntersectArea(t, t), 50, 1e-9);
+    BOOST_CHECK_CLOSE(Builder::GetIntersectArea(t, triangle({0, 10}, {10, 0}, {0, 0})), 50, 1e-9);//reversed orientation
+    BOOST_CHECK_CLOSE(Builder::GetIntersectArea(t, triangle({1, 1}, {3, 1}, {1, 3})), 2, 1e-9);//nested
+    BOOST_CHECK_CLOSE(Builder::GetIntersectArea(triangle({-5, 5}, {5, -5}, {5, 5}), t), 25, 1e-9);//clipped to a square
+    BOOST_CHECK(Builder::GetIntersectArea(t, triangle({10, 0}, {0, 10}, {10, 10})) == 0);//shared edge
+    BOOST_CHECK(Builder::GetIntersectArea(t, triangle({10, 0}, {20, 0}, {10, 10})) == 0);//shared vertex
+    BOOST_CHECK(Builder::GetIntersectArea(t, triangle({20, 20}, {30, 20}, {20, 30})) == 0);//disjoint
+}
+
 test_suite * create_ecad_model_test_suite()
 {
     test_suite * model_suite = BOOST_TEST_SUITE("s_model_test");
     //
     model_suite->add(BOOST_TEST_CASE(&s_ctm_model_io_test));
+    model_suite->add(BOOST_TEST_CASE(&s_ctm_binary_io_test));
+    model_suite->add(BOOST_TEST_CASE(&s_vtu_writer_test));
+    model_suite->add(BOOST_TEST_CASE(&s_triangle_intersect_area_test));
     //
     return model_suite;
 }
\ No newline at end of file
@@ -5,14 +5,45 @@
 #include "generic/tools/Format.hpp"
 #include "generic/tools/FileSystem.hpp"
 #include "solver/thermal/EThermalNetworkSolver.h"
+#include "solver/thermal/utils/EMaterialTable.h"
+#include "interface/IMaterialDefCollection.h"
+#include "interface/IMaterialDef.h"
 #include "model/thermal/io/EThermalModelIO.h"
 #include "model/thermal/io/EGridThermalModelIO.h"
 #include "model/thermal/utils/EThermalModelReduction.h"
+#include "solver/thermal/network/ThermalNetworkSolver.h"
 #include "TestData.hpp"
+#include <filesystem>
+#include <map>
 using namespace boost::unit_test;
 using namespace ecad;
 using namespace ecad::solver;
 using namespace ecad::model;
+namespace ecad_test {
+///@brief nx x nx x nz block of nodes, lateral resistance layerR(k) within layer k and verticalRatio * layerR(k) to the layer above,
+///       cooled by htc at the bottom layer and heated by hf on the top layer, node (i, j, k) is (k * nx + j) * nx + i
+template <typename Scalar, typename LayerR>
+inline UPtr<thermal::model::ThermalNetwork<Scalar> > CreateLayeredNetwork(size_t nx, size_t nz, LayerR && layerR, Scalar verticalRatio, Scalar htc, Scalar hf)
+{
+    auto id = [&](size_t i, size_t j, size_t k) { return (k * nx + j) * nx + i; };
+    auto network = std::make_unique<thermal::model::ThermalNetwork<Scalar> >(nx * nx * nz);
+    for (size_t k = 0; k < nz; ++k) {
+        Scalar r = layerR(k);
+        for (size_t j = 0; j < nx; ++j) {
+            for (size_t i = 0; i < nx; ++i) {
+                if (i + 1 < nx) network->SetR(id(i, j, k), id(i + 1, j, k), r);
+                if (j + 1 < nx) network->SetR(id(i, j, k), id(i, j + 1, k), r);
+                if (k + 1 < nz) network->SetR(id(i, j, k), id(i, j, k + 1), verticalRatio * r);
+                if (0 == k) network->SetHTC(id(i, j, k), htc);
+                if (nz == k + 1 && hf != 0) network->SetHF(id(i, j, k), hf);
+            }
+        }
+    }
+    network->Compress();
+    return network;
+}
+} // namespace ecad_test
+
 void t_grid_thermal_model_solver_test()
 {
     std::string err;
@@ -20,9 +51,9 @@ void t_grid_thermal_model_solver_test()
     std::string ctm = ecad_test::GetTestDataPath() + "/ctm/test.tar.gz";
     std::string ctmFolder = ecad_test::GetTestDataPath() + "/ctm/test";
     auto model = io::makeGridThermalModelFromCTMv1File(ctm, 0, &err);
-    BOOST_CHECK(generic::fs::PathExists(ctmFolder));
-    generic::fs::RemoveDir(ctmFolder);
-    BOOST_CHECK(model);
+    BOOST_CHECK(not generic::fs::PathExists(ctmFolder));//read in process, nothing staged next to the archive
+    BOOST_CHECK(err.empty());
+    BOOST_REQUIRE(model);
     
     auto size = model->ModelSize();
     ECAD_TRACE("size: (%1%, %2%)", size.x, size.y);
@@ -44,11 +75,206 @@ void t_grid_thermal_model_solver_test()
     //max: 99.4709, min: 81.9183
 }
 
+void t_thermal_network_amg_solver_test()
+{
+    //layered block, alternating copper and dielectric layers with a cooled bottom and heat on top,
+    //float as in the static solver, the contrast is kept to what a float residual can resolve
+    using Scalar = Float32;
+    auto layerR = [](size_t k) { return (k / 2) % 2 ? Scalar(1e3) : Scalar(1); };
+    auto pNetwork = ecad_test::CreateLayeredNetwork<Scalar>(24, 8, layerR, 1e-2, 1e-1, 1);
+    const auto & network = *pNetwork;
+
+    using namespace thermal::solver;
+    Scalar refT = 25;
+    std::vector<Scalar> diagonal, amg;
+    ThermalNetworkStaticSolveSession<Scalar> diagonalSession(static_cast<int>(EThermalNetworkStaticSolverType::ConjugateGradient));
+    ThermalNetworkStaticSolveSession<Scalar> amgSession(static_cast<int>(EThermalNetworkStaticSolverType::ConjugateGradientAMG));
+    diagonalSession.Solve(network, refT, diagonal);
+    amgSession.Solve(network, refT, amg);
+    BOOST_CHECK(amgSession.Iterations() < diagonalSession.Iterations());
+    //both stop at a relative residual of the same tolerance, so compare the rise over refT within 0.5%
+    for (size_t i = 0; i < network.Size(); ++i)
+        BOOST_CHECK_CLOSE(diagonal.at(i) - refT, amg.at(i) - refT, 0.5);
+}
+
+void t_thermal_network_multi_rhs_solver_test()
+{
+    using Scalar = Float32;
+    const size_t nx = 16, nz = 4;
+    auto pNetwork = ecad_test::CreateLayeredNetwork<Scalar>(nx, nz, [](size_t) { return Scalar(1); }, 1e-1, 1e-2, 0);
+    const auto & network = *pNetwork;
+
+    //more columns than one substitution block, each one heats a different node
+    using namespace thermal::solver;
+    using Session = ThermalNetworkStaticSolveSession<Scalar>;
+    const size_t cols = Session::blockCols + 8;
+    typename Session::DenseMatrix B = Session::DenseMatrix::Zero(network.Size(), cols), X;
+    for (size_t c = 0; c < cols; ++c) {
+        for (size_t n = 0; n < network.Size(); ++n)
+            B(n, c) = network.GetHTC(n) * 25;
+        B((nz - 1) * nx * nx + c, c) += 1;//top layer
+    }
+    for (auto type : {EThermalNetworkStaticSolverType::SparseLU, EThermalNetworkStaticSolverType::Cholesky,
+                      EThermalNetworkStaticSolverType::LLT, EThermalNetworkStaticSolverType::LDLT,
+                      EThermalNetworkStaticSolverType::ConjugateGradient, EThermalNetworkStaticSolverType::ConjugateGradientAMG}) {
+        Session session(static_cast<int>(type));
+        session.Prepare(network);
+        session.Solve(B, X, 2);
+        BOOST_REQUIRE(X.cols() == Eigen::Index(cols));
+        for (size_t c = 0; c < cols; c += 7) {
+            std::vector<Scalar> x;
+            session.Solve(DenseVector<Scalar>(B.col(c)), x);
+            for (size_t n = 0; n < network.Size(); n += 13)
+                BOOST_CHECK_CLOSE(X(n, c), x.at(n), 0.1);
+        }
+    }
+}
+
+void t_thermal_network_snapshot_test()
+{
+    using Scalar = Float32;
+    auto pNetwork = ecad_test::CreateLayeredNetwork<Scalar>(12, 3, [](size_t) { return Scalar(1); }, 1e-1, 1e-2, 1e-3);
+    const auto & network = *pNetwork;
+
+    //the replayed solve of the dumped system must reproduce the original one bit by bit
+    using namespace thermal::solver;
+    using namespace thermal::utils;
+    Scalar refT = 25;
+    std::vector<Scalar> reference, replay;
+    auto dumpDir = (std::filesystem::temp_directory_path() / "ecad_snapshot_test").string();
+    ThermalNetworkStaticSolveSession<Scalar> session(static_cast<int>(EThermalNetworkStaticSolverType::LLT));
+    session.Solve(network, refT, reference, dumpDir);
+    BOOST_CHECK(generic::fs::FileExists(dumpDir + "/G.mtx"));
+
+    ThermalNetworkSnapshot<Scalar> snapshot;
+    BOOST_CHECK(ThermalNetworkSnapshotIO::ScalarSize(dumpDir + "/snapshot.bin") == sizeof(Scalar));
+    BOOST_REQUIRE(ThermalNetworkSnapshotIO::Read(dumpDir + "/snapshot.bin", snapshot));
+    BOOST_CHECK(snapshot.refT == refT);
+    BOOST_CHECK(snapshot.G.rows() == Eigen::Index(network.Size()));
+    ThermalNetworkStaticSolveSession<Scalar> replaySession(snapshot.solverType);
+    replaySession.Prepare(snapshot.G);
+    BOOST_CHECK(0 == snapshot.x0.size());
+    replaySession.Solve(generic::ckt::DenseVector<Scalar>(snapshot.B * snapshot.rhs), replay);
+    BOOST_CHECK(replay == reference);
+
+    //a warm started solve records its initial guess
+    auto guess = reference;
+    session.Solve(network, refT, reference, dumpDir);
+    BOOST_REQUIRE(ThermalNetworkSnapshotIO::Read(dumpDir + "/snapshot.bin", snapshot));
+    BOOST_CHECK(std::vector<Scalar>(snapshot.x0.data(), snapshot.x0.data() + snapshot.x0.size()) == guess);
+    generic::fs::RemoveDir(dumpDir);
+}
+
+void t_thermal_network_implicit_transient_test()
+{
+    //single rc node to ambient with a heat source, c * dT/dt = -htc * (T - refT) + hf, decays exponentially to refT + hf / htc
+    using Scalar = double;
+    using namespace thermal::solver;
+    using Solver = ThermalNetworkImplicitTransientSolver<Scalar>;
+    const Scalar c = 2, htc = 4, hf = 8, refT = 25, iniT = 20, duration = 1;
+    thermal::model::ThermalNetwork<Scalar> network(1);
+    network.SetC(0, c);
+    network.SetHTC(0, htc);
+    network.SetHF(0, hf);
+    auto exact = [&](Scalar t) { auto steadyT = refT + hf / htc; return steadyT + (iniT - steadyT) * std::exp(-htc / c * t); };
+    auto excitation = [](Scalar, size_t) { return Scalar{1}; };
+    auto observer = [](const auto &, Scalar) {};
+    auto fixedStepError = [&](ImplicitMethod method, Scalar dt) {
+        Solver solver(network, refT, {0}, method);
+        std::vector<Scalar> x{iniT};
+        BOOST_CHECK(solver.Solve(x, Scalar{0}, duration, dt, Scalar{0}, Scalar{0}, observer, &excitation) > 0);
+        return std::fabs(x.front() - exact(duration));
+    };
+    auto adaptiveSolve = [&](ImplicitMethod method, Scalar tolerance) {
+        Solver solver(network, refT, {0}, method);
+        std::vector<Scalar> x{iniT};
+        auto steps = solver.SolveAdaptive(x, Scalar{0}, duration, Scalar(1e-3), tolerance, Scalar{0}, observer, &excitation);
+        return std::make_pair(steps, std::fabs(x.front() - exact(duration)));
+    };
+
+    std::map<ImplicitMethod, size_t> orders{{ImplicitMethod::BackwardEuler, 1}, {ImplicitMethod::Trapezoidal, 2}, {ImplicitMethod::BDF2, 2}};
+    for (auto [method, order] : orders) {
+        //halving the step divides the global error by 2^order
+        auto coarse = fixedStepError(method, 0.02);
+        auto fine = fixedStepError(method, 0.01);
+        BOOST_CHECK_CLOSE(coarse / fine, std::pow(2, order), 5);
+
+        //the step controller meets a tighter tolerance with more steps
+        auto [looseSteps, looseError] = adaptiveSolve(method, 1e-4);
+        auto [tightSteps, tightError] = adaptiveSolve(method, 1e-6);
+        BOOST_CHECK(tightSteps > looseSteps);
+        BOOST_CHECK(tightError < looseError / 3);
+        BOOST_CHECK(tightError < 1e-3);
+        if (order > 1) BOOST_CHECK(tightSteps < adaptiveSolve(ImplicitMethod::BackwardEuler, 1e-6).first);
+
+        //a solve that continues after Update() keeps the history, same result as one solve over the whole duration
+        Solver whole(network, refT, {0}, method), split(network, refT, {0}, method);
+        std::vector<Scalar> x1{iniT}, x2{iniT};
+        whole.Solve(x1, Scalar{0}, duration, Scalar(0.01), Scalar{0}, Scalar{0}, observer, &excitation);
+        split.Solve(x2, Scalar{0}, duration / 2, Scalar(0.01), Scalar{0}, Scalar{0}, observer, &excitation);
+        split.Update(network);
+        split.Solve(x2, duration / 2, duration / 2, Scalar(0.01), Scalar{0}, Scalar{0}, observer, &excitation);
+        BOOST_CHECK_CLOSE(x1.front(), x2.front(), 1e-9);
+    }
+}
+
+void t_material_table_test()
+{
+    EDataMgr::Instance().Init();
+    auto & eDataMgr = EDataMgr::Instance();
+    auto database = eDataMgr.CreateDatabase("MaterialTable"); BOOST_REQUIRE(database);
+    auto matCu = database->CreateMaterialDef("Cu");
+    matCu->SetProperty(EMaterialPropId::ThermalConductivity, eDataMgr.CreatePolynomialMaterialProp({{437.6, -0.165, 1.825e-4, -1.427e-7, 3.979e-11}}));
+    matCu->SetProperty(EMaterialPropId::SpecificHeat, eDataMgr.CreatePolynomialMaterialProp({{342.8, 0.134, 5.535e-5, -1.971e-7, 1.141e-10}}));
+    matCu->SetProperty(EMaterialPropId::MassDensity, eDataMgr.CreateSimpleMaterialProp(8850));
+    auto matFR4 = database->CreateMaterialDef("FR4");
+    matFR4->SetProperty(EMaterialPropId::ThermalConductivity, eDataMgr.CreateAnisotropicMaterialProp({0.8, 0.8, 0.3}));
+    matFR4->SetProperty(EMaterialPropId::SpecificHeat, eDataMgr.CreateSimpleMaterialProp(1100));
+    auto matSiC = database->CreateMaterialDef("SiC");
+    matSiC->SetProperty(EMaterialPropId::ThermalConductivity, eDataMgr.CreatePolynomialMaterialProp({{490, -0.2}, {490, -0.2}, {370, -0.1}}));
+
+    using Property = EMaterialTable::Property;
+    EMaterialTable table(database->GetMaterialDefCollection());
+    BOOST_CHECK(not table.hasProperty(matFR4->GetMaterialId(), Property::MassDensity));
+    BOOST_CHECK(not table.hasProperty(matSiC->GetMaterialId(), Property::Resistivity));
+    //missing properties and unknown materials are rejected when they are required
+    const auto unknown = static_cast<EMaterialId>(1000);
+    BOOST_CHECK(table.isValid());
+    BOOST_CHECK(not table.hasProperty(unknown, Property::ThermalConductivity));
+    BOOST_CHECK(std::isnan(table.GetSimpleProperty(matFR4->GetMaterialId(), Property::MassDensity, 300)));
+    BOOST_CHECK(std::isnan(table.GetAnisotropicProperty(unknown, Property::ThermalConductivity, 300).front()));
+    BOOST_CHECK(EMaterialTable(database->GetMaterialDefCollection(), {{matCu->GetMaterialId(), Property::MassDensity}}).isValid());
+    BOOST_CHECK(not EMaterialTable(database->GetMaterialDefCollection(), {{matFR4->GetMaterialId(), Property::MassDensity}}).isValid());
+    BOOST_CHECK(not EMaterialTable(database->GetMaterialDefCollection(), {{unknown, Property::ThermalConductivity}}).isValid());
+    for (auto material : {matCu, matFR4, matSiC}) {
+        auto id = material->GetMaterialId();
+        BOOST_CHECK(table.hasProperty(id, Property::ThermalConductivity));
+        for (EFloat t = 250; t < 500; t += 25) {
+            auto k = table.GetAnisotropicProperty(id, Property::ThermalConductivity, t);
+            for (size_t row = 0; row < 3; ++row) {
+                EFloat ref{0};
+                BOOST_CHECK(material->GetProperty(EMaterialPropId::ThermalConductivity)->GetAnisotropicProperty(t, row, ref));
+                BOOST_CHECK_CLOSE(k.at(row), ref, 1e-8);
+            }
+            if (not table.hasProperty(id, Property::SpecificHeat)) continue;
+            EFloat ref{0};
+            BOOST_CHECK(material->GetProperty(EMaterialPropId::SpecificHeat)->GetSimpleProperty(t, ref));
+            BOOST_CHECK_CLOSE(table.GetSimpleProperty(id, Property::SpecificHeat, t), ref, 1e-8);
+        }
+    }
+    EDataMgr::Instance().ShutDown();
+}
+
 test_suite * create_ecad_solver_test_suite()
 {
     test_suite * solver_suite = BOOST_TEST_SUITE("s_solver_test");
     //
     solver_suite->add(BOOST_TEST_CASE(&t_grid_thermal_model_solver_test));
+    solver_suite->add(BOOST_TEST_CASE(&t_thermal_network_amg_solver_test));
+    solver_suite->add(BOOST_TEST_CASE(&t_thermal_network_multi_rhs_solver_test));
+    solver_suite->add(BOOST_TEST_CASE(&t_thermal_network_implicit_transient_test));
+    solver_suite->add(BOOST_TEST_CASE(&t_thermal_network_snapshot_test));
+    solver_suite->add(BOOST_TEST_CASE(&t_material_table_test));
     //
     return solver_suite;
 }
\ No newline at end of file